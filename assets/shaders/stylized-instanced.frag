@@ -0,0 +1,10 @@
+#version 330
+
+flat in vec4 v_modulate;
+
+out vec4 out_color;
+
+void main() 
+{
+	out_color = v_modulate;
+}
\ No newline at end of file
@@ -0,0 +1,29 @@
+#version 330
+
+uniform mat4 u_view_projection;
+//  dequantize positions from the bounds of the mesh
+uniform vec3 u_position_offset;
+uniform vec3 u_position_scale;
+
+//  only positions are read, normals and uvs aren't bound
+layout( location = 0 ) in vec3 in_position;
+
+//  Per-instance attributes, the matrix rows take locations 3 to 6
+layout( location = 3 ) in mat4 in_world_transform;
+layout( location = 7 ) in vec4 in_modulate;
+layout( location = 8 ) in float in_outline_scale;
+
+flat out vec4 v_modulate;
+
+void main() 
+{
+	//  scale about the model origin to draw the outline with the same matrix
+	vec3 position = in_position * u_position_scale + u_position_offset;
+	vec4 pos = vec4( position * ( 1.0f + in_outline_scale ), 1.0f );
+
+	//  rows are read as columns, so the world transform is on the left side
+	pos = in_world_transform * pos;
+	gl_Position = pos * u_view_projection;
+
+	v_modulate = in_modulate;
+}
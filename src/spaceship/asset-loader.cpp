@@ -0,0 +1,69 @@
+#include "asset-loader.h"
+
+using namespace spaceship;
+
+AssetLoader::AssetLoader( const int workers_count )
+	: _workers( workers_count )
+{}
+
+AssetLoader::~AssetLoader()
+{
+	// Completions reference assets owners, they must run before destruction
+	wait();
+}
+
+void AssetLoader::run_async( WorkerTask task )
+{
+	_pending_count++;
+	_workers.submit(
+		[this, task = std::move( task )]
+		{
+			MainThreadTask completion = task();
+			_push_main_thread_task( std::move( completion ) );
+		}
+	);
+}
+
+void AssetLoader::run_on_main_thread( MainThreadTask task )
+{
+	_pending_count++;
+	_push_main_thread_task( std::move( task ) );
+}
+
+bool AssetLoader::poll()
+{
+	std::deque<MainThreadTask> tasks;
+	{
+		std::lock_guard lock( _mutex );
+		tasks.swap( _main_thread_tasks );
+	}
+
+	for ( MainThreadTask& task : tasks )
+	{
+		if ( task )
+		{
+			task();
+		}
+		_pending_count--;
+	}
+
+	return is_ready();
+}
+
+void AssetLoader::wait()
+{
+	while ( !poll() )
+	{
+		std::unique_lock lock( _mutex );
+		_condition.wait( lock, [this] { return !_main_thread_tasks.empty(); } );
+	}
+}
+
+void AssetLoader::_push_main_thread_task( MainThreadTask task )
+{
+	{
+		std::lock_guard lock( _mutex );
+		_main_thread_tasks.push_back( std::move( task ) );
+	}
+	_condition.notify_one();
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+
+#include <spaceship/utils/worker-pool.h>
+
+namespace spaceship
+{
+	/*
+	 * Completion handle of assets loading. File reads and decoding run on worker
+	 * threads, while their completions, e.g. OpenGL uploads and registering into
+	 * the engine's assets, are queued and run on the main thread when polling.
+	 *
+	 * Assets are available through the engine once the handle is ready.
+	 */
+	class AssetLoader
+	{
+	public:
+		using MainThreadTask = std::function<void()>;
+		using WorkerTask = std::function<MainThreadTask()>;
+
+	public:
+		explicit AssetLoader( int workers_count = WorkerPool::get_default_threads_count() );
+		~AssetLoader();
+
+		/*
+		 * Runs the task on a worker thread, the returned task, if any, is then
+		 * run on the main thread.
+		 */
+		void run_async( WorkerTask task );
+		void run_on_main_thread( MainThreadTask task );
+
+		/*
+		 * Runs completed tasks on the main thread, returns whether all tasks
+		 * are done.
+		 */
+		bool poll();
+		/*
+		 * Blocks the main thread until all tasks are done, running completions
+		 * as they come.
+		 */
+		void wait();
+
+		bool is_ready() const { return _pending_count.load() == 0; }
+		int get_pending_count() const { return _pending_count.load(); }
+
+	private:
+		void _push_main_thread_task( MainThreadTask task );
+
+	private:
+		std::atomic<int> _pending_count = 0;
+
+		std::mutex _mutex;
+		std::condition_variable _condition;
+		std::deque<MainThreadTask> _main_thread_tasks;
+
+		//  Declared last to be destroyed, and joined, first
+		WorkerPool _workers;
+	};
+}
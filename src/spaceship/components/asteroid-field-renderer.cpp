@@ -0,0 +1,107 @@
+#include "asteroid-field-renderer.h"
+
+#include <spaceship/components/instanced-renderer.h>
+#include <spaceship/rendering/model-lods.h>
+#include <spaceship/systems/asteroid-field.h>
+
+#include <suprengine/core/assets.h>
+
+using namespace spaceship;
+
+AsteroidFieldRenderer::AsteroidFieldRenderer( const SharedPtr<AsteroidField>& field )
+	: _wk_field( field )
+{
+	_models.reserve( AsteroidField::MODELS_COUNT );
+	for ( int i = 0; i < AsteroidField::MODELS_COUNT; i++ )
+	{
+		const SharedPtr<Model> model = Assets::get_model( "asteroid" + std::to_string( i ) );
+		_models.push_back( model );
+
+		float min_half_extent = 0.0f;
+		float bounds_radius = 0.0f;
+		if ( model )
+		{
+			const Box& bounds = model->get_bounds();
+			const Vec3 half_extents = ( bounds.max - bounds.min ) * 0.5f;
+			min_half_extent = math::min( half_extents.x, math::min( half_extents.y, half_extents.z ) );
+			bounds_radius = half_extents.length();
+		}
+		_occluder_radiuses.push_back( min_half_extent );
+		_bounds_radiuses.push_back( bounds_radius );
+	}
+}
+
+void AsteroidFieldRenderer::render( RenderBatch* render_batch )
+{
+	const SharedPtr<AsteroidField> field = _wk_field.lock();
+	if ( !field ) return;
+
+	const SharedPtr<Camera> camera = render_batch->get_camera();
+	const Vec3 camera_location = camera->transform->location;
+
+	const int count = field->get_count();
+	std::vector<uint8>& lod_levels = _lod_levels.get( camera.get() );
+	lod_levels.resize( count, 0 );
+	for ( int i = 0; i < count; i++ )
+	{
+		// Destroyed, waiting to be removed
+		if ( !field->is_alive( i ) ) continue;
+
+		const int model_id = field->get_model_id( i );
+		const SharedPtr<Model>& model = _models[model_id];
+		if ( !model ) continue;
+
+		const Vec3 scale = field->get_scale( i );
+		const Vec3 location = field->get_location( i );
+
+		// Large asteroids hide what's behind
+		const float min_scale = math::min( scale.x, math::min( scale.y, scale.z ) );
+		if ( min_scale >= occluder_min_scale )
+		{
+			InstancedRenderer::add_occluder(
+				location,
+				_occluder_radiuses[model_id] * min_scale * occluder_ratio
+			);
+		}
+
+		// Pick level of detail from the screen size of the asteroid
+		const float max_scale = math::max( scale.x, math::max( scale.y, scale.z ) );
+		const float screen_size = ModelLods::compute_screen_size(
+			camera,
+			_bounds_radiuses[model_id] * max_scale * ( 1.0f + outline_scale ),
+			( location - camera_location ).length_sqr()
+		);
+		const int lod_level = ModelLods::select_level( model.get(), screen_size, lod_levels[i] );
+		lod_levels[i] = static_cast<uint8>( lod_level );
+		const SharedPtr<Model>& lod_model = ModelLods::get_level( model, lod_level );
+
+		// Both passes share the same matrix, the outline is scaled by the shader
+		const Mtx4 matrix = Mtx4::create_from_transform(
+			scale,
+			field->get_rotation( i ),
+			location
+		);
+
+		// Draw outline mesh
+		InstancedRenderer::draw_model(
+			render_batch,
+			matrix,
+			lod_model,
+			shader_name,
+			field->COLOR,
+			outline_scale,
+			true
+		);
+
+		// Draw inner mesh
+		InstancedRenderer::draw_model(
+			render_batch,
+			matrix,
+			lod_model,
+			shader_name,
+			inner_modulate,
+			0.0f,
+			false
+		);
+	}
+}
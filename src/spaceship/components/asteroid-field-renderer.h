@@ -0,0 +1,49 @@
+#pragma once
+
+#include <spaceship/rendering/per-camera-state.hpp>
+
+#include <suprengine/components/renderer.h>
+
+namespace spaceship
+{
+	using namespace suprengine;
+
+	class AsteroidField;
+
+	/*
+	 * Draws all asteroids of an AsteroidField, with one matrix per asteroid for both passes.
+	 * Each asteroid picks the level of detail of its model from its screen size.
+	 */
+	class AsteroidFieldRenderer : public Renderer
+	{
+	public:
+		AsteroidFieldRenderer( const SharedPtr<AsteroidField>& field );
+
+		void render( RenderBatch* render_batch ) override;
+
+	public:
+		std::string shader_name = "stylized";
+
+		float outline_scale = 0.025f;
+		Color inner_modulate = Color::black;
+
+		//  Minimum scale for an asteroid to be used as an occluder
+		float occluder_min_scale = 10.0f;
+		//  Radius of occluder spheres, relatively to the smallest half-extent of
+		//  the model bounds, small enough to stay inside the asteroid
+		float occluder_ratio = 0.5f;
+
+	private:
+		WeakPtr<AsteroidField> _wk_field;
+		std::vector<SharedPtr<Model>> _models;
+		//  Occluder radius of each model, at a scale of one
+		std::vector<float> _occluder_radiuses;
+		//  Bounding sphere radius of each model, at a scale of one
+		std::vector<float> _bounds_radiuses;
+
+		//  Level of detail of each asteroid drawn last frame by each camera, used for
+		//  hysteresis. Indices shift when asteroids are removed, which only resets
+		//  their hysteresis.
+		PerCameraState<std::vector<uint8>> _lod_levels;
+	};
+}
@@ -0,0 +1,230 @@
+#include "instanced-renderer.h"
+
+#include <suprengine/core/assets.h>
+#include <suprengine/components/camera.h>
+#include <suprengine/rendering/mesh.h>
+#include <suprengine/rendering/shader-program.h>
+#include <suprengine/rendering/vertex-array.h>
+#include <suprengine/utils/logger.h>
+
+#include <gl/glew.h>
+
+using namespace spaceship;
+
+WeakPtr<InstancedRenderer> InstancedRenderer::_wk_instance;
+
+InstancedRenderer::InstancedRenderer( const bool use_render_thread )
+	: Renderer( PRIORITY_ORDER ),
+	  _pipeline( use_render_thread )
+{}
+
+InstancedRenderer::~InstancedRenderer()
+{
+	_lean_models.clear();
+	if ( _instance_buffer_id != 0 )
+	{
+		glDeleteBuffers( 1, &_instance_buffer_id );
+	}
+}
+
+void InstancedRenderer::setup()
+{
+	_wk_instance = as<InstancedRenderer>();
+}
+
+void InstancedRenderer::render( RenderBatch* render_batch )
+{
+	const SharedPtr<ShaderProgram> shader = Assets::get_shader_program( INSTANCED_SHADER_NAME );
+	if ( !shader )
+	{
+		draw_list.clear();
+		return;
+	}
+
+	// Buffer is created on first use, once an OpenGL context exists
+	if ( _instance_buffer_id == 0 )
+	{
+		glGenBuffers( 1, &_instance_buffer_id );
+	}
+
+	// Hand the draws over with the camera state, in exchange for a culled frame
+	const SharedPtr<Camera> camera = render_batch->get_camera();
+	const CameraSnapshot camera_state {
+		.view_projection = camera->get_view_matrix() * camera->get_projection_matrix(),
+		.projection = camera->get_projection_matrix(),
+	};
+	RenderSnapshot* snapshot = _pipeline.exchange( camera.get(), camera_state, draw_list, is_occlusion_culling_enabled );
+	if ( snapshot == nullptr ) return;
+
+	InstancedDrawList& snapshot_draw_list = snapshot->draw_list;
+	if ( snapshot_draw_list.get_instances_count() == 0 )
+	{
+		snapshot_draw_list.clear();
+		return;
+	}
+
+	shader->activate();
+	shader->set_mtx4( "u_view_projection", snapshot->camera.view_projection );
+
+	for ( const DrawBatch& batch : snapshot_draw_list.get_batches() )
+	{
+		if ( batch.instances.empty() ) continue;
+
+		// Built before uploading instances since it binds other buffers
+		const LeanModel* lean_model = _get_lean_model( *batch.model );
+
+		glBindBuffer( GL_ARRAY_BUFFER, _instance_buffer_id );
+		glFrontFace( batch.key.is_front_face_ccw ? GL_CCW : GL_CW );
+		glBufferData(
+			GL_ARRAY_BUFFER,
+			static_cast<GLsizeiptr>( batch.instances.size() * sizeof( DrawInstance ) ),
+			batch.instances.data(),
+			GL_STREAM_DRAW
+		);
+
+		// Instance attributes are part of the lean vertex arrays state
+		if ( lean_model != nullptr )
+		{
+			for ( const LeanModel::LeanMesh& mesh : lean_model->get_meshes() )
+			{
+				glBindVertexArray( mesh.vertex_array_id );
+				shader->set_vec3( "u_position_offset", mesh.position_offset );
+				shader->set_vec3( "u_position_scale", mesh.position_scale );
+
+				glDrawElementsInstanced(
+					GL_TRIANGLES,
+					static_cast<GLsizei>( mesh.indices_count ),
+					GL_UNSIGNED_INT,
+					nullptr,
+					static_cast<GLsizei>( batch.instances.size() )
+				);
+			}
+			continue;
+		}
+
+		// Full format, positions are read as is
+		shader->set_vec3( "u_position_offset", Vec3::zero );
+		shader->set_vec3( "u_position_scale", Vec3::one );
+
+		const int meshes_count = batch.model->get_mesh_count();
+		for ( int i = 0; i < meshes_count; i++ )
+		{
+			VertexArray* vertex_array = batch.model->get_mesh( i )->get_vertex_array();
+			vertex_array->activate();
+			_bind_instance_attributes();
+
+			glDrawElementsInstanced(
+				GL_TRIANGLES,
+				static_cast<GLsizei>( vertex_array->get_indices_count() ),
+				GL_UNSIGNED_INT,
+				nullptr,
+				static_cast<GLsizei>( batch.instances.size() )
+			);
+		}
+	}
+
+	// Storage is re-used by the next frame of this camera
+	snapshot_draw_list.clear();
+}
+
+void InstancedRenderer::draw_model(
+	RenderBatch* render_batch,
+	const Mtx4& matrix,
+	const SharedPtr<Model>& model,
+	const std::string& shader_name,
+	const Color modulate,
+	const float outline_scale,
+	const bool is_front_face_ccw
+)
+{
+	if ( shader_name == SOURCE_SHADER_NAME )
+	{
+		if ( const SharedPtr<InstancedRenderer> instance = get_instance() )
+		{
+			instance->draw_list.add( model, is_front_face_ccw, matrix, modulate, outline_scale );
+			return;
+		}
+	}
+
+	// Without instancing, the outline scale is applied on the CPU
+	glFrontFace( is_front_face_ccw ? GL_CCW : GL_CW );
+	if ( outline_scale == 0.0f )
+	{
+		render_batch->draw_model( matrix, model, shader_name, modulate );
+	}
+	else
+	{
+		const Mtx4 outline_matrix = Mtx4::create_scale( Vec3( 1.0f + outline_scale ) ) * matrix;
+		render_batch->draw_model( outline_matrix, model, shader_name, modulate );
+	}
+}
+
+void InstancedRenderer::add_occluder( const Vec3& center, const float radius )
+{
+	if ( const SharedPtr<InstancedRenderer> instance = get_instance() )
+	{
+		instance->draw_list.add_occluder( center, radius );
+	}
+}
+
+const LeanModel* InstancedRenderer::_get_lean_model( const Model& model )
+{
+	const auto itr = _lean_models.find( &model );
+	if ( itr != _lean_models.end() ) return itr->second.get();
+
+	std::unique_ptr<LeanModel> lean_model = std::make_unique<LeanModel>();
+	if ( lean_model->build( model, should_quantize_positions ) )
+	{
+		// Instance buffer is the same for all batches, only its content changes
+		glBindBuffer( GL_ARRAY_BUFFER, _instance_buffer_id );
+		for ( const LeanModel::LeanMesh& mesh : lean_model->get_meshes() )
+		{
+			glBindVertexArray( mesh.vertex_array_id );
+			_bind_instance_attributes();
+		}
+	}
+	else
+	{
+		Logger::warning( "Failed to build position-only buffers of a model, drawing its full format instead." );
+		lean_model.reset();
+	}
+
+	const LeanModel* result = lean_model.get();
+	_lean_models.emplace( &model, std::move( lean_model ) );
+	return result;
+}
+
+void InstancedRenderer::_bind_instance_attributes() const
+{
+	constexpr GLsizei STRIDE = sizeof( DrawInstance );
+
+	// Matrix, one attribute per row
+	for ( uint32 row = 0; row < 4; row++ )
+	{
+		const uint32 location = INSTANCE_ATTRIBUTE_LOCATION + row;
+		glEnableVertexAttribArray( location );
+		glVertexAttribPointer(
+			location, 4, GL_FLOAT, GL_FALSE, STRIDE,
+			reinterpret_cast<const void*>( offsetof( DrawInstance, matrix ) + row * 4 * sizeof( float ) )
+		);
+		glVertexAttribDivisor( location, 1 );
+	}
+
+	// Modulate color, normalized from bytes
+	const uint32 modulate_location = INSTANCE_ATTRIBUTE_LOCATION + 4;
+	glEnableVertexAttribArray( modulate_location );
+	glVertexAttribPointer(
+		modulate_location, 4, GL_UNSIGNED_BYTE, GL_TRUE, STRIDE,
+		reinterpret_cast<const void*>( offsetof( DrawInstance, modulate ) )
+	);
+	glVertexAttribDivisor( modulate_location, 1 );
+
+	// Outline scale
+	const uint32 outline_location = INSTANCE_ATTRIBUTE_LOCATION + 5;
+	glEnableVertexAttribArray( outline_location );
+	glVertexAttribPointer(
+		outline_location, 1, GL_FLOAT, GL_FALSE, STRIDE,
+		reinterpret_cast<const void*>( offsetof( DrawInstance, outline_scale ) )
+	);
+	glVertexAttribDivisor( outline_location, 1 );
+}
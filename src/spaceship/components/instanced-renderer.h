@@ -0,0 +1,97 @@
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+
+#include <spaceship/rendering/instanced-draw-list.h>
+#include <spaceship/rendering/lean-model.h>
+#include <spaceship/rendering/render-pipeline.h>
+
+#include <suprengine/components/renderer.h>
+
+namespace spaceship
+{
+	using namespace suprengine;
+
+	/*
+	 * Submits the draws collected by other renderers during the frame as
+	 * instanced draw calls, with the matrix and modulate color sent per instance.
+	 *
+	 * Its priority makes it render after all other world renderers, so the draw
+	 * list is complete and flushed once per camera, after culling instances
+	 * outside of the camera frustum or hidden behind occluders.
+	 *
+	 * With the render thread, the draw list of a camera is handed over along with
+	 * its matrices and culled on that thread, while the list of the previous
+	 * frame is submitted.
+	 *
+	 * The instanced shader only reads positions, so models are drawn from a
+	 * position-only copy, built on their first draw.
+	 */
+	class InstancedRenderer : public Renderer
+	{
+	public:
+		explicit InstancedRenderer( bool use_render_thread = true );
+		~InstancedRenderer() override;
+
+		void setup() override;
+		void render( RenderBatch* render_batch ) override;
+
+		/*
+		 * Adds the model to the draw list if instancing is available for the
+		 * given shader, otherwise draws it immediately. The outline scale is
+		 * applied about the model origin by the shader, so outline and inner
+		 * passes can give the same matrix.
+		 */
+		static void draw_model(
+			RenderBatch* render_batch,
+			const Mtx4& matrix,
+			const SharedPtr<Model>& model,
+			const std::string& shader_name,
+			Color modulate,
+			float outline_scale,
+			bool is_front_face_ccw
+		);
+
+		/*
+		 * Adds an occluder sphere for the camera being rendered, if instancing
+		 * is available. The sphere must be fully inside the occluding geometry.
+		 */
+		static void add_occluder( const Vec3& center, float radius );
+
+		static SharedPtr<InstancedRenderer> get_instance() { return _wk_instance.lock(); }
+
+	public:
+		//  Shader drawn through instancing, other shaders are drawn immediately
+		static constexpr const char* SOURCE_SHADER_NAME = "stylized";
+		//  Shader used to draw instances
+		static constexpr const char* INSTANCED_SHADER_NAME = "stylized-instanced";
+
+		//  Render after all world renderers
+		static constexpr int PRIORITY_ORDER = 1000;
+
+		InstancedDrawList draw_list;
+
+		bool is_occlusion_culling_enabled = true;
+		//  Quantize positions of position-only models to 16-bits, applies to models built afterwards
+		bool should_quantize_positions = true;
+
+	private:
+		const LeanModel* _get_lean_model( const Model& model );
+		void _bind_instance_attributes() const;
+
+	private:
+		//  First vertex attribute location of the per-instance data
+		static constexpr uint32 INSTANCE_ATTRIBUTE_LOCATION = 3;
+
+	private:
+		uint32 _instance_buffer_id = 0;
+
+		RenderPipeline _pipeline;
+
+		//  Null when the model couldn't be read back, its full format is drawn instead
+		std::unordered_map<const Model*, std::unique_ptr<LeanModel>> _lean_models {};
+
+		static WeakPtr<InstancedRenderer> _wk_instance;
+	};
+}
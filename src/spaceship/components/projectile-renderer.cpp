@@ -0,0 +1,40 @@
+#include "projectile-renderer.h"
+
+#include <spaceship/components/instanced-renderer.h>
+#include <spaceship/systems/projectile-system.h>
+
+using namespace spaceship;
+
+ProjectileRenderer::ProjectileRenderer(
+	const SharedPtr<ProjectileSystem>& system,
+	const SharedPtr<Model>& model
+)
+	: model( model ), _wk_system( system )
+{}
+
+void ProjectileRenderer::render( RenderBatch* render_batch )
+{
+	const SharedPtr<ProjectileSystem> system = _wk_system.lock();
+	if ( !system || !model ) return;
+
+	const std::vector<Vec3>& locations = system->get_locations();
+	const std::vector<Quaternion>& rotations = system->get_rotations();
+	const std::vector<Color>& colors = system->get_colors();
+
+	const Vec3 scale( system->PROJECTILE_SCALE );
+
+	const int count = system->get_count();
+	for ( int i = 0; i < count; i++ )
+	{
+		const Mtx4 matrix = Mtx4::create_from_transform( scale, rotations[i], locations[i] );
+		InstancedRenderer::draw_model(
+			render_batch,
+			matrix,
+			model,
+			shader_name,
+			colors[i],
+			outline_scale,
+			true
+		);
+	}
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <suprengine/components/renderer.h>
+
+namespace spaceship
+{
+	using namespace suprengine;
+
+	class ProjectileSystem;
+
+	/*
+	 * Draws all projectiles of a ProjectileSystem in a single pass, as outlines only.
+	 */
+	class ProjectileRenderer : public Renderer
+	{
+	public:
+		ProjectileRenderer(
+			const SharedPtr<ProjectileSystem>& system,
+			const SharedPtr<Model>& model
+		);
+
+		void render( RenderBatch* render_batch ) override;
+
+	public:
+		SharedPtr<Model> model;
+		std::string shader_name = "stylized";
+
+		float outline_scale = 0.025f;
+
+	private:
+		WeakPtr<ProjectileSystem> _wk_system;
+	};
+}
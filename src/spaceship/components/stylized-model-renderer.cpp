@@ -1,8 +1,9 @@
 #include "stylized-model-renderer.h"
 
-#include <suprengine/core/engine.h>
+#include <spaceship/components/instanced-renderer.h>
+#include <spaceship/rendering/model-lods.h>
 
-#include <gl/glew.h>
+#include <suprengine/core/engine.h>
 
 using namespace spaceship;
 
@@ -20,17 +21,19 @@ StylizedModelRenderer::StylizedModelRenderer(
 
 void StylizedModelRenderer::render( RenderBatch* render_batch )
 {
+	const SharedPtr<Camera> camera = render_batch->get_camera();
+
+	// Compute distances
+	const Vec3 dist = transform->location - camera->transform->location;
+	const float camera_dist_sqr = dist.length_sqr();
+
 	// Get offset scale
 	float offset_scale = 1.0f;
 	if ( dynamic_camera_distance_settings.is_active )
 	{
-		const SharedPtr<Camera> camera = render_batch->get_camera();
-
-		// Compute distances
-		const Vec3 dist = transform->location - camera->transform->location;
 		const float dist_sqr = math::min(
 			dynamic_camera_distance_settings.max_distance_sqr, 
-			dist.length_sqr()
+			camera_dist_sqr
 		);
 
 		// Add offset scale
@@ -46,34 +49,62 @@ void StylizedModelRenderer::render( RenderBatch* render_batch )
 		offset_scale += outline_scale;
 	}
 
-	// Draw outline mesh
-	if ( !math::near_value( offset_scale, 1.0f ) )
+	// Hide what's behind
+	if ( occluder_ratio > 0.0f && model )
 	{
-		//  compute outline matrix
-		const Mtx4 outline_matrix = Mtx4::create_from_transform(
-			transform->scale * offset_scale,
-			transform->rotation,
-			transform->location
+		const Box& bounds = model->get_bounds();
+		const Vec3 half_extents = ( bounds.max - bounds.min ) * 0.5f;
+		const float min_half_extent = math::min( half_extents.x, math::min( half_extents.y, half_extents.z ) );
+		const float min_scale = math::min( transform->scale.x, math::min( transform->scale.y, transform->scale.z ) );
+
+		InstancedRenderer::add_occluder(
+			transform->location,
+			min_half_extent * min_scale * occluder_ratio
 		);
+	}
 
-		glFrontFace( draw_outline_ccw ? GL_CCW : GL_CW );
-		render_batch->draw_model(
-			outline_matrix,
-			model,
+	// Pick level of detail from the screen size of the model
+	const SharedPtr<Model>* draw_model = &model;
+	if ( model && ModelLods::get_levels_count( model.get() ) > 1 )
+	{
+		const Box& bounds = model->get_bounds();
+		const float max_scale = math::max( transform->scale.x, math::max( transform->scale.y, transform->scale.z ) );
+		const float radius = ( bounds.max - bounds.min ).length() * 0.5f * max_scale * offset_scale;
+
+		const float screen_size = ModelLods::compute_screen_size( camera, radius, camera_dist_sqr );
+		int& lod_level = _lod_levels.get( camera.get() );
+		lod_level = ModelLods::select_level( model.get(), screen_size, lod_level );
+		draw_model = &ModelLods::get_level( model, lod_level );
+	}
+
+	// Both passes share the same matrix, the outline is scaled by the shader
+	const Mtx4& matrix = transform->get_matrix();
+
+	// Draw outline mesh
+	if ( !math::near_value( offset_scale, 1.0f ) )
+	{
+		InstancedRenderer::draw_model(
+			render_batch,
+			matrix,
+			*draw_model,
 			shader_name,
-			modulate
+			modulate,
+			offset_scale - 1.0f,
+			draw_outline_ccw
 		);
 	}
 
 	// Draw inner mesh
 	if ( !draw_only_outline )
 	{
-		glFrontFace( GL_CW );
-		render_batch->draw_model(
-			transform->get_matrix(),
-			model,
+		InstancedRenderer::draw_model(
+			render_batch,
+			matrix,
+			*draw_model,
 			shader_name,
-			inner_modulate
+			inner_modulate,
+			0.0f,
+			false
 		);
 	}
 }
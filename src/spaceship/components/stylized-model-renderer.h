@@ -1,5 +1,7 @@
 #pragma once
 
+#include <spaceship/rendering/per-camera-state.hpp>
+
 #include <suprengine/components/renderers/model-renderer.hpp>
 
 namespace spaceship
@@ -31,6 +33,17 @@ namespace spaceship
 
 		Color inner_modulate = Color::black;
 
+		/*
+		 * Radius of the occluder sphere, centered on the model origin, relatively
+		 * to the smallest half-extent of the model bounds. The sphere must stay
+		 * inside the model, zero to not occlude.
+		 */
+		float occluder_ratio = 0.0f;
+
 		CameraDynamicDistanceSettings dynamic_camera_distance_settings;
+
+	private:
+		//  Level of detail drawn last frame by each camera, used for hysteresis
+		PerCameraState<int> _lod_levels;
 	};
 }
\ No newline at end of file
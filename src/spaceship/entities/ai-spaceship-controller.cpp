@@ -1,10 +1,18 @@
 #include "ai-spaceship-controller.h"
 
+#include <spaceship/utils/command-buffer.h>
+
 using namespace spaceship;
 
 AISpaceshipController::AISpaceshipController()
 {}
 
+void AISpaceshipController::setup()
+{
+	// Targets are re-assigned by the world when lost
+	_world->targeting.register_controller( as<AISpaceshipController>() );
+}
+
 void AISpaceshipController::update_inputs( float dt )
 {
 	const SharedPtr<Spaceship> ship = get_ship();
@@ -14,8 +22,15 @@ void AISpaceshipController::update_inputs( float dt )
 		const Vec3 dir = target->transform->location - ship->transform->location;
 		const Vec3 normalized_dir = dir.normalized();
 
+		// Steer away from neighbors and obstacles on the way to the target
+		Vec3 steering_dir = normalized_dir + _compute_avoidance( *ship, *target );
+		if ( steering_dir.length_sqr() < 0.0001f )
+		{
+			steering_dir = normalized_dir;
+		}
+
 		const Quaternion desired_rotation = Quaternion::look_at( 
-			normalized_dir,
+			steering_dir.normalized(),
 			Vec3::up
 		);
 
@@ -27,7 +42,7 @@ void AISpaceshipController::update_inputs( float dt )
 		//  shoot if aligned
 		if ( ship->get_shoot_time() <= 0.0f && forward_alignement >= 0.9f )
 		{
-			ship->shoot();
+			CommandBuffer::defer( [ship] { ship->shoot(); } );
 		}
 
 		_inputs.throttle_delta = forward_alignement;
@@ -42,3 +57,48 @@ void AISpaceshipController::update_inputs( float dt )
 		_inputs.throttle_delta = 0.0f;
 	}
 }
+
+float AISpaceshipController::get_look_ahead_distance() const
+{
+	const SharedPtr<Spaceship> ship = get_ship();
+	if ( !ship ) return 0.0f;
+
+	return LOOK_AHEAD_MIN_DISTANCE + ship->get_speed() * LOOK_AHEAD_TIME;
+}
+
+Vec3 AISpaceshipController::_compute_avoidance( const Spaceship& ship, const Spaceship& target ) const
+{
+	const Vec3& location = ship.transform->location;
+	const uint32 unique_id = ship.get_unique_id();
+	// The target is chased, not avoided
+	const uint32 target_id = target.get_unique_id();
+
+	Vec3 avoidance = Vec3::zero;
+
+	// Separation from nearby spaceships, stronger when closer
+	const float separation_radius_sqr = SEPARATION_RADIUS * SEPARATION_RADIUS;
+	_world->spaceships_index.query_sphere( location, SEPARATION_RADIUS,
+		[&]( const SpatialGrid<World::SpaceshipIndexItem>::Entry& entry )
+		{
+			if ( entry.item.unique_id == unique_id || entry.item.unique_id == target_id ) return;
+
+			const Vec3 offset = location - entry.location;
+			const float distance_sqr = offset.length_sqr();
+			if ( distance_sqr >= separation_radius_sqr || distance_sqr < 0.0001f ) return;
+
+			const float distance = math::sqrt( distance_sqr );
+			avoidance += offset / distance * ( 1.0f - distance / SEPARATION_RADIUS ) * SEPARATION_WEIGHT;
+		}
+	);
+
+	// Obstacle found by the look-ahead probe, stronger when closer
+	if ( look_ahead_result.has_hit && look_ahead_result.entity_id != target_id )
+	{
+		const float look_ahead_distance = get_look_ahead_distance();
+		const float distance = ( look_ahead_result.hit.point - location ).length();
+		const float urgency = math::clamp( 1.0f - distance / look_ahead_distance, 0.0f, 1.0f );
+		avoidance += look_ahead_result.hit.normal * urgency * OBSTACLE_AVOIDANCE_WEIGHT;
+	}
+
+	return avoidance;
+}
@@ -11,9 +11,30 @@ namespace spaceship
 	public:
 		AISpaceshipController();
 
+		void setup() override;
+
 		void update_inputs( float dt ) override;
+		bool is_thread_safe() const override { return true; }
+		bool is_time_sliced() const override { return true; }
+		float get_look_ahead_distance() const override;
 
 	public:
 		WeakPtr<Spaceship> wk_target;
+
+	private:
+		//  Duration of flight probed ahead for obstacles
+		const float LOOK_AHEAD_TIME = 1.5f;
+		//  Distance probed ahead whatever the speed
+		const float LOOK_AHEAD_MIN_DISTANCE = 30.0f;
+		//  Weight of the obstacle normal when it is right in front of the spaceship
+		const float OBSTACLE_AVOIDANCE_WEIGHT = 3.0f;
+
+		//  Distance under which other spaceships are pushed away
+		const float SEPARATION_RADIUS = 40.0f;
+		//  Weight of the separation from a spaceship at the same location
+		const float SEPARATION_WEIGHT = 1.5f;
+
+	private:
+		Vec3 _compute_avoidance( const Spaceship& ship, const Spaceship& target ) const;
 	};
-}
\ No newline at end of file
+}
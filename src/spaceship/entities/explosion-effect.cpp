@@ -1,84 +1,126 @@
 #include "explosion-effect.h"
 
+#include <spaceship/utils/entity-pool.hpp>
+#include <spaceship/utils/simulation-checksum.h>
+
 #include <suprengine/core/assets.h>
 
 #include <suprengine/math/easing.h>
-#include <suprengine/utils/random.h>
 
 using namespace spaceship;
 
-ExplosionEffect::ExplosionEffect( 
+void ExplosionEffect::setup()
+{
+	// Cache models to avoid string lookups on each spawn
+	for ( int i = 0; i < MODELS_COUNT; i++ )
+	{
+		_models[i] = Assets::get_model( "explosion" + std::to_string( i ) );
+	}
+
+	_model_renderer = create_component<StylizedModelRenderer>(
+		_models[0],
+		Color::white/*color*/
+	);
+	//_model_renderer->draw_only_outline = true;
+
+	_lifetime_component = create_component<LifetimeComponent>( LIFETIME );
+	_lifetime_component->on_time_out.listen( &ExplosionEffect::release, this );
+
+	SimulationChecksum::track( *_world, as<Entity>() );
+}
+
+void ExplosionEffect::reset(
 	const float explosion_size,
 	const Color color,
 	int model_id
 )
-	: explosion_size( explosion_size ),
-	  color( color )
 {
+	this->explosion_size = explosion_size;
+	this->color = color;
+
 	// Randomize model if unspecified
 	if ( model_id < 0 )
 	{
-		model_id = random::generate( 0, 2 );
+		model_id = _world->random.generate( 0, MODELS_COUNT - 1 );
 	}
 	_model_id = model_id;
-}
 
-void ExplosionEffect::setup()
-{
-	_model_renderer = create_component<StylizedModelRenderer>(
-		Assets::get_model( "explosion" + std::to_string( _model_id ) ),
-		Color::white/*color*/
-	);
+	_model_renderer->model = _models[_model_id];
 	_model_renderer->inner_modulate = color/*Color::white*/;
-	//_model_renderer->draw_only_outline = true;
+	_model_renderer->is_active = true;
 
 	_max_lifetime = LIFETIME
-		+ random::generate( -LIFETIME_DEVIATION, LIFETIME_DEVIATION );
-
-	_lifetime_component = create_component<LifetimeComponent>( _max_lifetime );
-	_lifetime_component->on_time_out.listen( &Entity::kill, this );
+		+ _world->random.generate( -LIFETIME_DEVIATION, LIFETIME_DEVIATION );
+	_lifetime_component->life_time = _max_lifetime;
 	
 	_scale = Vec3 {
-		random::generate( RANDOM_SCALE[0] ),
-		random::generate( RANDOM_SCALE[1] ),
-		random::generate( RANDOM_SCALE[2] ),
+		_world->random.generate( RANDOM_SCALE[0] ),
+		_world->random.generate( RANDOM_SCALE[1] ),
+		_world->random.generate( RANDOM_SCALE[2] ),
+	};
+	transform->rotation = _world->random.generate_rotation();
+
+	// Don't show the previous explosion state for a frame
+	_update_visuals();
+}
+
+std::unique_ptr<CurveTable> ExplosionEffect::bake_curves( const int resolution )
+{
+	// Same order as the curve channels
+	const std::vector<SharedPtr<Curve>> curves {
+		Assets::get_curve( "explosion/transform-scale" ),
+		Assets::get_curve( "explosion/outline-scale" ),
+		Assets::get_curve( "explosion/outline-color" ),
+		Assets::get_curve( "explosion/inner-color" ),
 	};
-	transform->rotation = random::generate_rotation();
+	return std::make_unique<CurveTable>( curves, resolution );
+}
 
-	// Get curves
-	_curve_transform_scale = Assets::get_curve( "explosion/transform-scale" );
-	_curve_outline_scale = Assets::get_curve( "explosion/outline-scale" );
-	_curve_outline_color = Assets::get_curve( "explosion/outline-color" );
-	_curve_inner_color = Assets::get_curve( "explosion/inner-color" );
+void ExplosionEffect::release()
+{
+	_world->get_explosions_pool().release( as<ExplosionEffect>() );
+}
+
+void ExplosionEffect::hide()
+{
+	_model_renderer->is_active = false;
 }
 
 void ExplosionEffect::update_this( const float dt )
+{
+	_update_visuals();
+}
+
+void ExplosionEffect::_update_visuals()
 {
 	const float lifetime = _max_lifetime - _lifetime_component->life_time;
 	const float t = lifetime / _max_lifetime;
 
+	// Fetch all curves at once
+	float curves[CurveChannelsCount];
+	_world->explosion_curves->evaluate( t, curves );
+
 	// Lerp outline color
 	_model_renderer->modulate = Color::lerp(
 		Color::white, 
 		color,
-		_curve_outline_color->evaluate_by_time( t )
+		curves[OutlineColor]
 	);
 
 	// Lerp inner color
 	_model_renderer->inner_modulate = Color::lerp( 
 		color,
 		Color::black,
-		_curve_inner_color->evaluate_by_time( t )
+		curves[InnerColor]
 	);
 	
 	// Apply outline scale
-	_model_renderer->outline_scale = 
-		_curve_outline_scale->evaluate_by_time( t ) * OUTLINE_SCALE;
+	_model_renderer->outline_scale = curves[OutlineScale] * OUTLINE_SCALE;
 	
 	// Apply transform scale
 	transform->set_scale( 
 			explosion_size 
-		* _curve_transform_scale->evaluate_by_time( t ) 
+		* curves[TransformScale] 
 		* _scale
 	);
 }
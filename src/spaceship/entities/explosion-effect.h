@@ -1,31 +1,53 @@
 #pragma once
 
 #include <spaceship/components/stylized-model-renderer.h>
+#include <spaceship/utils/curve-table.h>
+#include <spaceship/world.h>
 
 #include <suprengine/core/entity.h>
 #include <suprengine/components/lifetime-component.h>
-#include <suprengine/utils/curve.h>
 
 namespace spaceship
 {
 	using namespace suprengine;
 
-	class ExplosionEffect : public Entity
+	/*
+	 * Pooled entity, spawn it with 'get_explosions_pool().acquire( size, color )' of its world.
+	 */
+	class ExplosionEffect : public WorldEntity
 	{
 	public:
-		ExplosionEffect( 
+		void setup() override;
+		void update_this( float dt ) override;
+
+		void reset( 
 			float explosion_size = 1.0f, 
 			Color color = Color::white,
 			int model_id = -1
 		);
+		void release();
+		void hide();
 
-		void setup() override;
-		void update_this( float dt ) override;
+
+		/*
+		 * Samples the explosion curves into a single table, must be called once
+		 * curves are loaded. Explosions read it from 'World::explosion_curves'.
+		 */
+		static std::unique_ptr<CurveTable> bake_curves( int resolution );
 
 	public:
 		float explosion_size = 1.0f;
 		Color color = Color::white;
 
+	public:
+		//  Number of explosions created in the pool when the scene starts
+		static constexpr int POOL_PREWARM_COUNT = 64;
+		//  Number of different explosion models
+		static constexpr int MODELS_COUNT = 3;
+
+	private:
+		void _update_visuals();
+
 	private:
 		//  Lifetime base value
 		const float LIFETIME = 1.5f;
@@ -44,16 +66,24 @@ namespace spaceship
 		};
 
 	private:
-		float _max_lifetime = 0.0f;
+		//  Valid before the first reset, as prewarmed explosions never had one
+		float _max_lifetime = LIFETIME;
 		Vec3 _scale = Vec3::one;
-		int _model_id;
+		int _model_id = 0;
+
+		SharedPtr<Model> _models[MODELS_COUNT];
 
 		SharedPtr<LifetimeComponent> _lifetime_component;
 		SharedPtr<StylizedModelRenderer> _model_renderer;
 
-		SharedPtr<Curve> _curve_transform_scale;
-		SharedPtr<Curve> _curve_outline_scale;
-		SharedPtr<Curve> _curve_outline_color;
-		SharedPtr<Curve> _curve_inner_color;
+		//  Channels of the curves table, in order
+		enum CurveChannel
+		{
+			TransformScale,
+			OutlineScale,
+			OutlineColor,
+			InnerColor,
+			CurveChannelsCount,
+		};
 	};
 }
\ No newline at end of file
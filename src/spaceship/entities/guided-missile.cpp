@@ -3,41 +3,58 @@
 #include <spaceship/components/health-component.h>
 #include <spaceship/entities/spaceship.h>
 #include <spaceship/entities/explosion-effect.h>
+#include <spaceship/physics/collision-broadphase.h>
+#include <spaceship/utils/entity-pool.hpp>
+#include <spaceship/utils/simulation-checksum.h>
 
 #include <suprengine/core/assets.h>
 #include <suprengine/core/engine.h>
-#include <suprengine/utils/random.h>
 
 using namespace spaceship;
 
-GuidedMissile::GuidedMissile(
-	const SharedPtr<Spaceship>& owner,
-	const WeakPtr<HealthComponent>& wk_target,
-	const Color color
-)
-	: _wk_owner( owner ), _wk_target( wk_target ), _color( color )
-{}
-
 void GuidedMissile::setup()
 {
 	_model_renderer = create_component<StylizedModelRenderer>(
-		Assets::get_model( "projectile" ),
-		_color
+		Assets::get_model( "projectile" )
 	);
 	_model_renderer->draw_only_outline = true;
 
 	_lifetime_component = create_component<LifetimeComponent>( LIFETIME );
 	_lifetime_component->on_time_out.listen( &GuidedMissile::explode, this );
 
+	SimulationChecksum::track( *_world, as<Entity>() );
+}
+
+void GuidedMissile::reset(
+	const SharedPtr<Spaceship>& owner,
+	const WeakPtr<HealthComponent>& wk_target,
+	const Color color,
+	const Vec3& location,
+	const Quaternion& rotation
+)
+{
+	_wk_owner = owner;
+	_owner_id = owner->get_unique_id();
+	_wk_target = wk_target;
+
+	transform->set_location( location );
+	transform->set_rotation( rotation );
+
+	_model_renderer->modulate = color;
+	_model_renderer->is_active = true;
+	_lifetime_component->life_time = LIFETIME;
+
 	_current_move_speed = move_speed * STARTING_MOVE_SPEED_RATIO;
+	_current_rotation_speed = 0.0f;
+	up_direction = Vec3::up;
 
 	//  set initial target direction
+	_desired_direction = Vec3::forward;
 	if ( const SharedPtr<HealthComponent> target = _wk_target.lock())
 	{
 		_desired_direction = 
 			( target->transform->location - transform->location ).normalized();
 	}
-
 }
 
 void GuidedMissile::update_this( float dt )
@@ -79,14 +96,23 @@ void GuidedMissile::explode()
 		}
 
 		const float size = explosion_size
-			+ random::generate( EXPLOSION_SIZE_DEVIATION.x, EXPLOSION_SIZE_DEVIATION.y );
+			+ _world->random.generate( EXPLOSION_SIZE_DEVIATION.x, EXPLOSION_SIZE_DEVIATION.y );
 
-		Engine& engine = Engine::instance();
-		const SharedPtr<ExplosionEffect> effect = engine.create_entity<ExplosionEffect>( size, color );
+		const SharedPtr<ExplosionEffect> effect = _world->get_explosions_pool().acquire( size, color );
 		effect->transform->location = transform->location;
 	}
 
-	kill();
+	release();
+}
+
+void GuidedMissile::release()
+{
+	_world->get_missiles_pool().release( as<GuidedMissile>() );
+}
+
+void GuidedMissile::hide()
+{
+	_model_renderer->is_active = false;
 }
 
 void GuidedMissile::_update_target( const float dt )
@@ -118,46 +144,47 @@ void GuidedMissile::_update_target( const float dt )
 
 void GuidedMissile::_check_impact()
 {
-	const Engine& engine = Engine::instance();
-	Physics* physics = engine.get_physics();
+	const SharedPtr<CollisionBroadphase> broadphase = _world->get_broadphase();
+	if ( !broadphase ) return;
 
-	// Setup raycast
-	const Ray ray(
+	// Setup query, ignoring the owner
+	SegmentQuery query {};
+	query.ray = Ray(
 		transform->location, 
 		transform->get_forward(), 
 		impact_distance 
 	);
-	RayParams params {};
-	params.can_hit_from_origin = false;
+	query.params.can_hit_from_origin = false;
+	query.ignored_entity_id = _owner_id;
 
 	// Check collisions
-	RayHit hit {};
-	if ( !physics->raycast( ray, &hit, params ) ) return;
-	
-	// Check entity is not owner
-	const SharedPtr<Entity> entity = hit.collider->get_owner();
-	if ( entity == _wk_owner.lock() ) return;
+	SegmentQueryResult result {};
+	if ( !broadphase->query_segment( query, &result ) ) return;
+
+	// Check entity has health component, source bodies are always damageable
+	Vec3 target_location = result.hit.point;
+	if ( result.body_source == nullptr )
+	{
+		const SharedPtr<Entity> entity = result.hit.collider->get_owner();
+		if ( !entity->find_component<HealthComponent>() ) return;
 
-	// Check entity has health component
-	const SharedPtr<HealthComponent> health = entity->find_component<HealthComponent>();
-	if ( !health ) return;
+		target_location = entity->transform->location;
+	}
 	
 	//  damage it
-	_damage( health );
+	_damage( result, target_location );
 }
 
-void GuidedMissile::_damage( const SharedPtr<HealthComponent>& target )
+void GuidedMissile::_damage( const SegmentQueryResult& hit_result, const Vec3& target_location )
 {
-	if ( !target ) return;
-	
-	const Vec3 diff = target->transform->location - transform->location;
+	const Vec3 diff = target_location - transform->location;
 
 	// Damage
 	DamageInfo info {};
 	info.attacker = _wk_owner.lock();
 	info.damage = damage_amount;
 	info.knockback = diff.normalized() * knockback_force;
-	const DamageResult result = target->damage( info );
+	const DamageResult result = CollisionBroadphase::damage( hit_result, info );
 
 	// Alert owner
 	if ( result.is_valid )
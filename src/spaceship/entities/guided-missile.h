@@ -2,6 +2,8 @@
 
 #include <spaceship/components/stylized-model-renderer.h>
 #include <spaceship/components/health-component.h>
+#include <spaceship/physics/collision-broadphase.h>
+#include <spaceship/world.h>
 
 #include <suprengine/core/entity.h>
 #include <suprengine/components/lifetime-component.h>
@@ -13,19 +15,25 @@ namespace spaceship
 	class Spaceship;
 	class HealthComponent;
 
-	class GuidedMissile : public Entity
+	/*
+	 * Pooled entity, spawn it with 'get_missiles_pool().acquire( ... )' of its world.
+	 */
+	class GuidedMissile : public WorldEntity
 	{
 	public:
-		GuidedMissile(
-			const SharedPtr<Spaceship>& owner,
-			const WeakPtr<HealthComponent>& wk_target,
-			Color color 
-		);
-
 		void setup() override;
 		void update_this( float dt ) override;
 
+		void reset(
+			const SharedPtr<Spaceship>& owner,
+			const WeakPtr<HealthComponent>& wk_target,
+			Color color,
+			const Vec3& location,
+			const Quaternion& rotation
+		);
 		void explode();
+		void release();
+		void hide();
 
 	public:
 		float move_speed = 175.0f;
@@ -42,11 +50,15 @@ namespace spaceship
 
 		Vec3 up_direction { Vec3::up };
 
+	public:
+		//  Number of missiles created in the pool when the scene starts
+		static constexpr int POOL_PREWARM_COUNT = 48;
+
 	private:
 		void _update_target( float dt );
 		void _check_impact();
 
-		void _damage(const SharedPtr<HealthComponent>& target );
+		void _damage( const SegmentQueryResult& hit_result, const Vec3& target_location );
 
 	private:
 		const float LIFETIME = 6.0f;
@@ -65,8 +77,7 @@ namespace spaceship
 		Vec3 _desired_direction { Vec3::forward };
 		WeakPtr<HealthComponent> _wk_target;
 		WeakPtr<Spaceship> _wk_owner;
-
-		Color _color;
+		uint32 _owner_id = 0;
 
 		SharedPtr<StylizedModelRenderer> _model_renderer;
 		SharedPtr<LifetimeComponent> _lifetime_component;
@@ -29,8 +29,6 @@ PlayerSpaceshipController::~PlayerSpaceshipController()
 
 void PlayerSpaceshipController::setup()
 {
-	auto& engine = Engine::instance();
-
 	hud = create_component<PlayerHUD>( as<PlayerSpaceshipController>() );
 
 	// Setup camera settings
@@ -39,7 +37,7 @@ void PlayerSpaceshipController::setup()
 	projection_settings.zfar = 10000.0f;
 
 	// Initialize camera
-	auto camera_owner = engine.create_entity<Entity>();
+	auto camera_owner = _world->create_entity<Entity>();
 	camera = camera_owner->create_component<Camera>( projection_settings );
 	camera->set_active();
 
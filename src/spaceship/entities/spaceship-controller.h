@@ -1,5 +1,8 @@
 #pragma once
 
+#include <spaceship/physics/segment-query.h>
+#include <spaceship/world.h>
+
 #include <suprengine/core/entity.h>
 #include <suprengine/utils/event.h>
 
@@ -18,7 +21,7 @@ namespace spaceship
 		float smooth_rotation_speed = 1.0f;
 	};
 
-	class SpaceshipController : public Entity
+	class SpaceshipController : public WorldEntity
 	{
 	public:
 		virtual ~SpaceshipController();
@@ -34,6 +37,28 @@ namespace spaceship
 		virtual void on_unpossess() {};
 
 		virtual void update_inputs( float dt ) = 0;
+		/*
+		 * Whether inputs can be updated in a job, in parallel with other
+		 * controllers. Such controllers only read other entities and defer
+		 * their effects through command buffers.
+		 */
+		virtual bool is_thread_safe() const { return false; }
+		/*
+		 * Whether inputs can be kept for several frames when the spaceship is
+		 * far from viewers, see AIUpdateScheduler. Such controllers must be
+		 * thread-safe.
+		 */
+		virtual bool is_time_sliced() const { return false; }
+		/*
+		 * Length of the segment probed ahead of the spaceship before planning,
+		 * zero to disable. Probes of all controllers are answered in a single
+		 * batch, see Spaceship::update_all.
+		 */
+		virtual float get_look_ahead_distance() const { return 0.0f; }
+
+	public:
+		//  Closest obstacle hit by the look-ahead probe of the current frame
+		SegmentQueryResult look_ahead_result {};
 
 	public:
 		/*
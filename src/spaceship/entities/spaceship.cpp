@@ -1,16 +1,20 @@
 #include "spaceship.h"
 
+#include <chrono>
+#include <limits>
+
 #include <spaceship/entities/guided-missile.h>
 #include <spaceship/entities/explosion-effect.h>
+#include <spaceship/physics/collision-broadphase.h>
+#include <spaceship/systems/projectile-system.h>
+#include <spaceship/utils/entity-pool.hpp>
+#include <spaceship/utils/job-system.h>
+#include <spaceship/utils/simulation-checksum.h>
 
 #include <suprengine/core/assets.h>
-#include <suprengine/core/engine.h>
-#include <suprengine/utils/random.h>
 
 using namespace spaceship;
 
-std::vector<WeakPtr<Spaceship>> Spaceship::_all_spaceships;
-
 Spaceship::Spaceship() 
 {}
 
@@ -27,7 +31,7 @@ Spaceship::~Spaceship()
 	}
 
 	//  remove from list
-	std::erase_if( _all_spaceships, 
+	std::erase_if( _world->spaceships, 
 		[this]( const WeakPtr<Spaceship>& wk_ship )
 		{
 			const SharedPtr<Spaceship> ship = wk_ship.lock();
@@ -40,8 +44,6 @@ Spaceship::~Spaceship()
 
 void Spaceship::setup()
 {
-	auto& engine = Engine::instance();
-
 	CameraDynamicDistanceSettings dcd_settings {};
 	dcd_settings.is_active = true;
 	dcd_settings.max_distance_sqr = math::pow( 256.0f, 2.0f );
@@ -55,9 +57,10 @@ void Spaceship::setup()
 	_model_renderer->dynamic_camera_distance_settings = dcd_settings;
 	_model_renderer->outline_scale = MODEL_OUTLINE_SCALE;
 	_collider = create_component<BoxCollider>( Box::one * 2.0f );
+	CollisionBroadphase::register_collider( *_world, _collider, BOUNDING_RADIUS );
 
 	// Initialize trail
-	const SharedPtr<Entity> trail_entity = engine.create_entity<Entity>();
+	const SharedPtr<Entity> trail_entity = _world->create_entity<Entity>();
 	_trail_renderer = trail_entity->create_component<StylizedModelRenderer>(
 		_model_renderer->model,
 		_color
@@ -72,16 +75,122 @@ void Spaceship::setup()
 	_health->on_damage.listen( &Spaceship::_on_damage, this );
 
 	// Add to list
-	_all_spaceships.push_back( as<Spaceship>() );
+	_world->spaceships.push_back( as<Spaceship>() );
+	SimulationChecksum::track( *_world, as<Entity>(), _health );
 }
 
-void Spaceship::update_this( const float dt )
+void Spaceship::update_all( World& world, const float dt )
 {
-	_update_movement( dt );
-	_update_trail( dt );
+	std::vector<SharedPtr<Spaceship>>& update_list = world.spaceships_update_list;
+	std::vector<CommandBuffer>& update_commands = world.spaceships_update_commands;
+
+	update_list.clear();
+	for ( const WeakPtr<Spaceship>& wk_ship : world.spaceships )
+	{
+		const SharedPtr<Spaceship> ship = wk_ship.lock();
+		if ( ship == nullptr || ship->state != EntityState::Active ) continue;
+
+		update_list.push_back( ship );
+	}
+
+	// Controllers which can't run in jobs are updated first, e.g. players
+	for ( const SharedPtr<Spaceship>& ship : update_list )
+	{
+		const SharedPtr<SpaceshipController> controller = ship->wk_controller.lock();
+		if ( controller && controller->is_thread_safe() ) continue;
+
+		ship->_update_inputs( dt );
+	}
+
+	// Select time-sliced controllers planning this frame, far ones keep their last inputs
+	const int count = static_cast<int>( update_list.size() );
+	std::vector<AIPlanCandidate>& candidates = world.ai_plan_candidates;
+	candidates.resize( count );
+	int planning_count = 0;
+	for ( int i = 0; i < count; i++ )
+	{
+		const Spaceship& ship = *update_list[i];
+		const SharedPtr<SpaceshipController> controller = ship.wk_controller.lock();
+
+		// Without viewers, all candidates are planned as near ones
+		float viewer_distance_sqr = 0.0f;
+		if ( controller && controller->is_time_sliced() && !world.viewer_locations.empty() )
+		{
+			viewer_distance_sqr = std::numeric_limits<float>::max();
+			for ( const Vec3& viewer_location : world.viewer_locations )
+			{
+				viewer_distance_sqr = math::min(
+					viewer_distance_sqr,
+					( ship.transform->location - viewer_location ).length_sqr()
+				);
+			}
+		}
+
+		candidates[i] = AIPlanCandidate { viewer_distance_sqr, ship._last_plan_tick, ship.get_unique_id() };
+	}
+	world.ai_scheduler.schedule( candidates, world.ai_should_plan );
+	const std::vector<uint8>& should_plan = world.ai_should_plan;
+	const uint64 plan_tick = world.ai_scheduler.get_tick();
+
+	for ( int i = 0; i < count; i++ )
+	{
+		const SharedPtr<SpaceshipController> controller = update_list[i]->wk_controller.lock();
+		if ( !should_plan[i] || !controller || !controller->is_thread_safe() ) continue;
+
+		planning_count++;
+	}
+
+	_probe_look_ahead( world, should_plan );
 
-	// Reduce shoot cooldown
-	_shoot_time = math::max( 0.0f, _shoot_time - dt );
+	// Other controllers only read spaceships, which haven't moved yet
+	const std::chrono::steady_clock::time_point planning_start_time = std::chrono::steady_clock::now();
+	update_commands.resize( JobSystem::get_chunks_count( count, UPDATE_CHUNK_SIZE ) );
+	JobSystem::run_parallel( world.job_system, count, UPDATE_CHUNK_SIZE,
+		[&update_list, &update_commands, &should_plan, plan_tick, dt]( const int chunk_index, const int begin, const int end )
+		{
+			CommandBuffer::Scope scope( update_commands[chunk_index] );
+			for ( int i = begin; i < end; i++ )
+			{
+				Spaceship& ship = *update_list[i];
+				const SharedPtr<SpaceshipController> controller = ship.wk_controller.lock();
+				if ( !controller || !controller->is_thread_safe() ) continue;
+
+				ship._update_inputs( dt, should_plan[i] != 0 );
+				if ( should_plan[i] )
+				{
+					ship._last_plan_tick = plan_tick;
+				}
+			}
+		}
+	);
+	if ( world.ai_scheduler.budget_us > 0.0f )
+	{
+		const std::chrono::duration<float, std::micro> planning_duration =
+			std::chrono::steady_clock::now() - planning_start_time;
+		world.ai_scheduler.report_duration( planning_duration.count(), planning_count );
+	}
+
+	// Sync point: apply shots and other effects in chunks order
+	CommandBuffer::execute_all( update_commands );
+
+	// Movements only write to their own spaceship and trail
+	JobSystem::run_parallel( world.job_system, count, UPDATE_CHUNK_SIZE,
+		[&update_list, dt]( int, const int begin, const int end )
+		{
+			for ( int i = begin; i < end; i++ )
+			{
+				Spaceship& ship = *update_list[i];
+				ship._update_movement( dt );
+				ship._update_trail( dt );
+
+				// Reduce shoot cooldown
+				ship._shoot_time = math::max( 0.0f, ship._shoot_time - dt );
+			}
+		}
+	);
+
+	// Don't extend lifetimes beyond the update
+	update_list.clear();
 }
 
 SharedPtr<Spaceship> Spaceship::find_lockable_target( 
@@ -93,59 +202,89 @@ SharedPtr<Spaceship> Spaceship::find_lockable_target(
 	float best_view_alignment = -1.0f;
 	float best_distance = MISSILE_LOCK_MAX_DISTANCE;
 
-	for ( const WeakPtr<Spaceship>& wk_ship : _all_spaceships )
+	const float max_distance_sqr = MISSILE_LOCK_MAX_DISTANCE * MISSILE_LOCK_MAX_DISTANCE;
+	const float dot_threshold_sqr = MISSILE_LOCK_DOT_THRESHOLD * MISSILE_LOCK_DOT_THRESHOLD;
+	const uint32 unique_id = get_unique_id();
+
+	// Only visit cells around the view cone
+	_world->spaceships_index.query_cone(
+		transform->location,
+		view_direction,
+		MISSILE_LOCK_MAX_DISTANCE,
+		MISSILE_LOCK_DOT_THRESHOLD,
+		[&]( const SpatialGrid<World::SpaceshipIndexItem>::Entry& entry )
+		{
+			if ( entry.item.unique_id == unique_id ) return;
+
+			const Vec3 diff = entry.location - transform->location;
+
+			// Check distance
+			const float distance_sqr = diff.length_sqr();
+			if ( distance_sqr >= max_distance_sqr ) return;
+
+			// Check direction, without normalizing: dot( diff / distance, view ) > threshold
+			const float dot = Vec3::dot( diff, view_direction );
+			if ( dot <= 0.0f || dot * dot <= dot_threshold_sqr * distance_sqr ) return;
+
+			// Only candidates inside the cone need their actual distance
+			const float distance = math::sqrt( distance_sqr );
+			const float view_alignment = dot / distance;
+			if ( distance >= best_distance && view_alignment < best_view_alignment ) return;
+
+			// Check health
+			const SharedPtr<Spaceship> ship = entry.item.wk_ship.lock();
+			if ( ship == nullptr || !ship->get_health_component()->is_alive() ) return;
+
+			best_distance = math::min( distance, best_distance );
+			best_view_alignment = math::max( view_alignment, best_view_alignment );
+			target = ship;
+		}
+	);
+
+	return target;
+}
+
+void Spaceship::update_spatial_index( World& world )
+{
+	world.spaceships_index.clear();
+
+	for ( const WeakPtr<Spaceship>& wk_ship : world.spaceships )
 	{
 		const SharedPtr<Spaceship> ship = wk_ship.lock();
-		if ( ship == nullptr || ship.get() == this ) continue;
-		
-		// Check health
-		const SharedPtr<HealthComponent> health = ship->get_health_component();
-		if ( !health->is_alive() ) continue;
-
-		Vec3 diff = ship->transform->location - transform->location;
-		
-		// Check distance
-		float distance = diff.length();
-		if ( distance >= MISSILE_LOCK_MAX_DISTANCE ) continue;
-
-		// Check direction
-		Vec3 direction = diff * ( 1.0f / distance );
-		float view_alignment = Vec3::dot( direction, view_direction );
-		if ( view_alignment <= MISSILE_LOCK_DOT_THRESHOLD ) continue;
-	
-		if ( distance >= best_distance && view_alignment < best_view_alignment ) continue;
-
-		best_distance = math::min( distance, best_distance );
-		best_view_alignment = math::max( view_alignment, best_view_alignment );
-		target = ship;
+		if ( ship == nullptr || ship->state != EntityState::Active ) continue;
+
+		world.spaceships_index.insert(
+			ship->transform->location,
+			World::SpaceshipIndexItem { ship, ship->get_unique_id() }
+		);
 	}
 
-	return target;
+	world.spaceships_index.build();
 }
 
 void Spaceship::shoot()
 {
-	Engine& engine = Engine::instance();
+	const SharedPtr<ProjectileSystem> projectile_system = _world->get_projectile_system();
+	if ( !projectile_system ) return;
+
 	const SharedPtr<Spaceship> shared_this = as<Spaceship>();
 
 	// Spawn projectile
 	for ( int i = 0; i < 2; i++ )
 	{
-		const SharedPtr<Projectile> projectile = engine.create_entity<Projectile>(
-			shared_this,
-			_color
-		);
-		projectile->transform->scale = Vec3( 1.5f );
-		projectile->transform->location = 
+		ProjectileSpawnInfo info {};
+		info.location = 
 			get_shoot_location( 
 				Vec3 {
-					projectile->transform->scale.x,
+					projectile_system->PROJECTILE_SCALE,
 					i == 0 ? -1.0f : 1.0f,
 					1.0f
 				} 
 			);
-		projectile->transform->rotation = transform->rotation;
-		projectile->damage_amount = 25.0f;
+		info.rotation = transform->rotation;
+		info.color = _color;
+		info.damage_amount = 25.0f;
+		projectile_system->spawn( shared_this, info );
 	}
 
 	//  put on cooldown
@@ -156,36 +295,11 @@ void Spaceship::launch_missiles(
 	const WeakPtr<HealthComponent>& wk_target
 )
 {
-	Engine& engine = Engine::instance();
-	const SharedPtr<Spaceship> shared_this = as<Spaceship>();
-
-	constexpr int MISSILES_COUNT = 6;
-	for ( int i = 0; i < MISSILES_COUNT; i++ )
-	{
-		float row = math::floor( static_cast<float>( i ) / 2.0f );
-		Timer timer(
-			[&engine, shared_this, wk_target, this, i, row]{
-				const SharedPtr<GuidedMissile> missile = engine.create_entity<GuidedMissile>(
-					shared_this,
-					wk_target,
-					_color
-				);
-				missile->transform->location = transform->location 
-					+ transform->get_right() * ( i % 2 == 0 ? 1.0f : -1.0f ) * 2.0f
-					+ transform->get_forward() * row * 3.0f;
-				missile->transform->rotation = Quaternion::look_at( transform->get_up(), Vec3::up );
-				missile->up_direction = transform->get_up();
-			},
-			row * 0.1f
-		);
-		engine.add_timer( timer );
-	}
+	_world->sequences.start( _launch_missiles_sequence( wk_target ), as<Entity>() );
 }
 
 void Spaceship::die()
 {
-	Engine& engine = Engine::instance();
-
 	if ( _health->health > 0.0f )
 	{
 		_health->health = 0.0f;
@@ -206,9 +320,9 @@ void Spaceship::die()
 			0.0f, 1.0f 
 		);
 		float size = math::lerp( EXPLOSION_SIZE.x, EXPLOSION_SIZE.y, size_ratio_over_damage );
-		size += random::generate( EXPLOSION_SIZE_DEVIATION.x, EXPLOSION_SIZE_DEVIATION.y );
+		size += _world->random.generate( EXPLOSION_SIZE_DEVIATION.x, EXPLOSION_SIZE_DEVIATION.y );
 
-		const SharedPtr<ExplosionEffect> effect = engine.create_entity<ExplosionEffect>(
+		const SharedPtr<ExplosionEffect> effect = _world->get_explosions_pool().acquire(
 			size,
 			_color
 		);
@@ -216,7 +330,7 @@ void Spaceship::die()
 	}
 	printf( "Spaceship[%d] is killed!\n", get_unique_id() );
 
-	TIMER( 5.0f, { respawn(); } );
+	_world->sequences.start( _respawn_sequence(), as<Entity>() );
 }
 
 void Spaceship::respawn()
@@ -253,16 +367,98 @@ void Spaceship::set_color( const Color& color )
 	_trail_renderer->modulate = _color;
 }
 
-void Spaceship::_update_movement( const float dt )
+void Spaceship::_update_inputs( const float dt, const bool should_plan )
 {
-	// Get inputs
-	SpaceshipControlInputs inputs {};
+	_inputs = SpaceshipControlInputs {};
+	_has_controller = false;
+
 	if ( const SharedPtr<SpaceshipController> controller = wk_controller.lock())
 	{
-		controller->update_inputs( dt );
-		inputs = controller->get_inputs();
+		// Otherwise, reuse the last planned inputs
+		if ( should_plan )
+		{
+			controller->update_inputs( dt );
+		}
+		_inputs = controller->get_inputs();
+		_has_controller = true;
+	}
+}
+
+Sequence Spaceship::_launch_missiles_sequence( const WeakPtr<HealthComponent> wk_target )
+{
+	// Launch by rows of two missiles
+	constexpr int MISSILES_COUNT = 6;
+	for ( int i = 0; i < MISSILES_COUNT; i++ )
+	{
+		const float row = math::floor( static_cast<float>( i ) / 2.0f );
+		if ( i > 0 && i % 2 == 0 )
+		{
+			co_await wait_seconds( MISSILES_ROW_DELAY );
+		}
+
+		const SharedPtr<GuidedMissile> missile = _world->get_missiles_pool().acquire(
+			as<Spaceship>(),
+			wk_target,
+			_color,
+			transform->location 
+				+ transform->get_right() * ( i % 2 == 0 ? 1.0f : -1.0f ) * 2.0f
+				+ transform->get_forward() * row * 3.0f,
+			Quaternion::look_at( transform->get_up(), Vec3::up )
+		);
+		missile->up_direction = transform->get_up();
 	}
+}
+
+Sequence Spaceship::_respawn_sequence()
+{
+	co_await wait_seconds( RESPAWN_DELAY );
+	respawn();
+}
+
+void Spaceship::_probe_look_ahead( World& world, const std::vector<uint8>& should_plan )
+{
+	const std::vector<SharedPtr<Spaceship>>& update_list = world.spaceships_update_list;
+	std::vector<SegmentQuery>& queries = world.look_ahead_queries;
+	std::vector<SegmentQueryResult>& results = world.look_ahead_results;
+	std::vector<int>& indices = world.look_ahead_indices;
+
+	queries.clear();
+	indices.clear();
+	for ( int i = 0; i < static_cast<int>( update_list.size() ); i++ )
+	{
+		if ( !should_plan[i] ) continue;
 
+		const Spaceship& ship = *update_list[i];
+		const SharedPtr<SpaceshipController> controller = ship.wk_controller.lock();
+		if ( !controller ) continue;
+
+		controller->look_ahead_result = SegmentQueryResult {};
+
+		const float distance = controller->get_look_ahead_distance();
+		if ( distance <= 0.0f ) continue;
+
+		SegmentQuery query {};
+		query.ray = Ray( ship.transform->location, ship.transform->get_forward(), distance );
+		query.ignored_entity_id = ship.get_unique_id();
+		queries.push_back( query );
+		indices.push_back( i );
+	}
+
+	const SharedPtr<CollisionBroadphase> broadphase = world.get_broadphase();
+	if ( queries.empty() || !broadphase ) return;
+
+	// Answered in a single batch, split into jobs by the broadphase
+	broadphase->query_segments( queries, results );
+	for ( size_t i = 0; i < indices.size(); i++ )
+	{
+		const SharedPtr<SpaceshipController> controller = update_list[indices[i]]->wk_controller.lock();
+		controller->look_ahead_result = results[i];
+	}
+}
+
+void Spaceship::_update_movement( const float dt )
+{
+	const SpaceshipControlInputs& inputs = _inputs;
 	const float throttle_delta = inputs.throttle_delta;
 	const float throttle_speed = THROTTLE_GAIN_SPEED;
 
@@ -290,7 +486,7 @@ void Spaceship::_update_movement( const float dt )
 	transform->set_location( transform->location + movement );
 
 	// Apply rotation and avoid identity rotation when no controller
-	if ( SharedPtr<SpaceshipController> controller = wk_controller.lock())
+	if ( _has_controller )
 	{
 		const Quaternion rotation = inputs.should_smooth_rotation
 			? Quaternion::slerp( transform->rotation, inputs.desired_rotation, dt * inputs.smooth_rotation_speed )
@@ -302,8 +498,9 @@ void Spaceship::_update_movement( const float dt )
 
 void Spaceship::_update_trail( float dt )
 {
-	Engine& engine = Engine::instance();
-	const float time = engine.get_updater()->get_accumulated_seconds();
+	// Use own time instead of the engine's one to keep the simulation deterministic
+	_trail_time += dt;
+	const float time = _trail_time;
 
 	//  intensity
 	float trail_intensity_target = 0.0f;
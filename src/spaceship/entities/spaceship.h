@@ -3,7 +3,7 @@
 #include <spaceship/components/stylized-model-renderer.h>
 #include <spaceship/components/health-component.h>
 #include <spaceship/entities/spaceship-controller.h>
-#include <spaceship/entities/projectile.h>
+#include <spaceship/world.h>
 
 #include <suprengine/components/colliders/box-collider.h>
 
@@ -11,19 +11,32 @@ namespace spaceship
 {
 	using namespace suprengine;
 
-	class Spaceship : public Entity
+	class Spaceship : public WorldEntity
 	{
 	public:
 		Spaceship();
 		~Spaceship();
 
 		void setup() override;
-		void update_this( float dt ) override;
 
 		SharedPtr<Spaceship> find_lockable_target(
 			const Vec3& view_direction 
 		) const;
 
+		/*
+		 * Re-builds the spatial index of the world's live spaceships, used by spatial
+		 * queries such as find_lockable_target. Must be called once per frame.
+		 */
+		static void update_spatial_index( World& world );
+		/*
+		 * Updates the world's live spaceships, in jobs when possible: inputs are
+		 * updated first, while spaceships haven't moved yet, then movements are
+		 * applied. Time-sliced controllers far from the world's viewers keep
+		 * their last inputs on some frames, look-ahead probes of the planning
+		 * ones are answered in a single batch. Must be called once per frame.
+		 */
+		static void update_all( World& world, float dt );
+
 		void shoot();
 		void launch_missiles(const WeakPtr<HealthComponent>& wk_target);
 		
@@ -34,6 +47,7 @@ namespace spaceship
 		float get_shoot_time() const { return _shoot_time; }
 
 		float get_throttle() const { return _throttle; }
+		float get_speed() const { return _throttle * MAX_THROTTLE_SPEED; }
 
 		void set_color( const Color& color );
 		Color get_color() const { return _color; }
@@ -56,6 +70,9 @@ namespace spaceship
 		//  Outline scale on models renderers
 		const float MODEL_OUTLINE_SCALE = 0.03f;
 
+		//  Radius of a sphere enclosing the collision box, used by the broadphase
+		const float BOUNDING_RADIUS = 3.5f;
+
 		//  Throttle gain per second
 		const float THROTTLE_GAIN_SPEED = 0.65f;
 		//  Max throttle offset by keeping forward pressed
@@ -97,7 +114,20 @@ namespace spaceship
 		//  Explosion random size deviation
 		const Vec2  EXPLOSION_SIZE_DEVIATION { -1.0f, 2.0f };
 
+		//  Delay between two rows of launched missiles
+		const float MISSILES_ROW_DELAY = 0.1f;
+		//  Delay before respawning once killed
+		const float RESPAWN_DELAY = 5.0f;
+
+		//  Spaceships updated per job, fixed so results don't depend on the threads count
+		static constexpr int UPDATE_CHUNK_SIZE = 8;
+
 	private:
+		Sequence _launch_missiles_sequence( WeakPtr<HealthComponent> wk_target );
+		Sequence _respawn_sequence();
+
+		void _update_inputs( float dt, bool should_plan = true );
+		static void _probe_look_ahead( World& world, const std::vector<uint8>& should_plan );
 		void _update_movement( float dt );
 		void _update_trail( float dt );
 
@@ -106,15 +136,20 @@ namespace spaceship
 	private:
 		float _throttle = 0.0f;
 		float _trail_intensity = 0.0f;
+		float _trail_time = 0.0f;
 		Color _color = Color::green;
 
 		float _shoot_time = 0.0f;
 
+		//  Inputs of the current frame, read from the controller
+		SpaceshipControlInputs _inputs {};
+		bool _has_controller = false;
+		//  Tick of the AI scheduler at which the controller last planned its inputs
+		uint64 _last_plan_tick = 0;
+
 		SharedPtr<StylizedModelRenderer> _model_renderer;
 		SharedPtr<StylizedModelRenderer> _trail_renderer;
 		SharedPtr<BoxCollider> _collider;
 		SharedPtr<HealthComponent> _health;
-
-		static std::vector<WeakPtr<Spaceship>> _all_spaceships;
 	};
 }
\ No newline at end of file
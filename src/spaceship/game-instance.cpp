@@ -1,5 +1,11 @@
 #include "game-instance.h"
 
+#include <chrono>
+#include <iterator>
+
+#include <spaceship/entities/explosion-effect.h>
+#include <spaceship/rendering/mesh-cache.h>
+#include <spaceship/rendering/model-lods.h>
 #include <spaceship/scenes/game-scene.h>
 
 #include <suprengine/core/assets.h>
@@ -10,42 +16,185 @@
 
 using namespace spaceship;
 
+GameLaunchSettings GameInstance::default_launch_settings {};
+
+GameInstance::GameInstance()
+	: GameInstance( default_launch_settings )
+{}
+
+GameInstance::GameInstance( const GameLaunchSettings& launch_settings )
+	: _launch_settings( launch_settings )
+{
+	const int threads_count = _launch_settings.job_threads_count >= 0
+		? _launch_settings.job_threads_count
+		: WorkerPool::get_default_threads_count();
+	_job_system = std::make_unique<JobSystem>( threads_count );
+	Logger::info( "Running jobs on %d worker threads.", _job_system->get_threads_count() );
+}
+
 void GameInstance::load_assets()
 {
-    // Shaders
-	Assets::load_shader_program(
-		ShaderProgramAssetInfo {
-			.name = "stylized",
-			.shaders =
-			{
-				{ "assets/spaceship/shaders/stylized.vert", ShaderType::Vertex },
-				{ "assets/spaceship/shaders/stylized.frag", ShaderType::Fragment },
-			},
-		}
-	);
-
-	// Textures
-	Assets::load_texture(
-		"crosshair-line",
-		"assets/spaceship/sprites/crosshair-line.png" 
-	);
-	Assets::load_texture(
-		"kill-icon",
-		"assets/spaceship/sprites/kill-icon.png" 
-	);
-
-	// Models
-	Assets::load_model( "spaceship", "assets/spaceship/models/spaceship2.fbx" );
-	Assets::load_model( "projectile", "assets/spaceship/models/projectile.fbx" );
-	Assets::load_model( "planet-ring", "assets/spaceship/models/planet-ring.fbx" );
-	Assets::load_model( "asteroid0", "assets/spaceship/models/asteroid0.fbx" );
-	Assets::load_model( "asteroid1", "assets/spaceship/models/asteroid1.fbx" );
-	Assets::load_model( "explosion0", "assets/spaceship/models/explosion0.fbx" );
-	Assets::load_model( "explosion1", "assets/spaceship/models/explosion1.fbx" );
-	Assets::load_model( "explosion2", "assets/spaceship/models/explosion2.fbx" );
+	_asset_loader = load_assets_async();
+}
+
+SharedPtr<AssetLoader> GameInstance::load_assets_async()
+{
+	const SharedPtr<AssetLoader> loader = std::make_shared<AssetLoader>();
+
+	// Models, shaders and textures need an OpenGL context, which doesn't exist in headless mode
+	const bool has_context = !_launch_settings.is_headless;
+
+	// Models first, so workers read them while the main thread loads other assets
+	if ( !has_context || _launch_settings.should_skip_models )
+	{
+		Logger::info( "Skipping models loading." );
+	}
+	else
+	{
+		_load_models( *loader );
+	}
+
+	if ( has_context )
+	{
+		// Shaders
+		Assets::load_shader_program(
+			ShaderProgramAssetInfo {
+				.name = "stylized",
+				.shaders =
+				{
+					{ "assets/spaceship/shaders/stylized.vert", ShaderType::Vertex },
+					{ "assets/spaceship/shaders/stylized.frag", ShaderType::Fragment },
+				},
+			}
+		);
+		Assets::load_shader_program(
+			ShaderProgramAssetInfo {
+				.name = "stylized-instanced",
+				.shaders =
+				{
+					{ "assets/spaceship/shaders/stylized-instanced.vert", ShaderType::Vertex },
+					{ "assets/spaceship/shaders/stylized-instanced.frag", ShaderType::Fragment },
+				},
+			}
+		);
+
+		// Textures
+		Assets::load_texture(
+			"crosshair-line",
+			"assets/spaceship/sprites/crosshair-line.png" 
+		);
+		Assets::load_texture(
+			"kill-icon",
+			"assets/spaceship/sprites/kill-icon.png" 
+		);
+	}
 
 	// Curves
 	Assets::load_curves_in_folder( "assets/spaceship/curves/", true, true );
+	_explosion_curves = ExplosionEffect::bake_curves( _launch_settings.curve_table_resolution );
+
+	return loader;
+}
+
+void GameInstance::_load_models( AssetLoader& loader )
+{
+	using clock = std::chrono::steady_clock;
+
+	struct ModelAsset
+	{
+		const char* name;
+		const char* path;
+		//  Large models seen from afar get simplified levels of detail
+		bool should_generate_lods;
+	};
+	const ModelAsset MODELS[] {
+		{ "spaceship", "assets/spaceship/models/spaceship2.fbx", false },
+		{ "projectile", "assets/spaceship/models/projectile.fbx", false },
+		{ "planet-ring", "assets/spaceship/models/planet-ring.fbx", true },
+		{ "asteroid0", "assets/spaceship/models/asteroid0.fbx", true },
+		{ "asteroid1", "assets/spaceship/models/asteroid1.fbx", true },
+		{ "explosion0", "assets/spaceship/models/explosion0.fbx", false },
+		{ "explosion1", "assets/spaceship/models/explosion1.fbx", false },
+		{ "explosion2", "assets/spaceship/models/explosion2.fbx", false },
+	};
+	constexpr int MODELS_COUNT = static_cast<int>( std::size( MODELS ) );
+
+	const clock::time_point start_time = clock::now();
+
+	// Without cache, always parse sources, which uploads to OpenGL
+	if ( !_launch_settings.use_mesh_cache )
+	{
+		for ( const auto& [name, path, should_generate_lods] : MODELS )
+		{
+			const SharedPtr<Model> model = Assets::load_model( name, path );
+			if ( should_generate_lods )
+			{
+				ModelLods::generate( model );
+			}
+		}
+
+		const double milliseconds = std::chrono::duration<double, std::milli>( clock::now() - start_time ).count();
+		Logger::info( "Loaded models from sources in %.2fms.", milliseconds );
+		return;
+	}
+
+	// Shared by completions, which all run on the main thread
+	struct LoadState
+	{
+		MeshCache cache { MESH_CACHE_PATH };
+		int remaining_count = MODELS_COUNT;
+	};
+	const SharedPtr<LoadState> state = std::make_shared<LoadState>();
+
+	for ( const auto& [name, path, should_generate_lods] : MODELS )
+	{
+		loader.run_async(
+			[state, start_time, name, path, should_generate_lods]() -> AssetLoader::MainThreadTask
+			{
+				// Map and validate the cooked file on the worker
+				auto cooked_model = std::make_shared<MeshCache::CookedModel>( state->cache.read( name, path ) );
+
+				// Simplify from the mapping while still on the worker
+				auto lods = std::make_shared<ModelLods::SimplifiedLevels>();
+				if ( should_generate_lods && cooked_model->is_valid )
+				{
+					*lods = ModelLods::simplify( cooked_model->meshes );
+				}
+
+				// Upload on the main thread
+				return [state, start_time, cooked_model, lods, should_generate_lods]
+				{
+					const bool is_cooked = cooked_model->is_valid;
+					const SharedPtr<Model> model = state->cache.finish( *cooked_model );
+					if ( should_generate_lods )
+					{
+						if ( is_cooked )
+						{
+							ModelLods::add( model, *lods );
+						}
+						else
+						{
+							// Imported from source, its buffers are only on the GPU
+							ModelLods::generate( model );
+						}
+					}
+
+					if ( --state->remaining_count > 0 ) return;
+
+					// Cold when any model had to be cooked
+					const MeshCache& cache = state->cache;
+					const double milliseconds = std::chrono::duration<double, std::milli>( clock::now() - start_time ).count();
+					Logger::info(
+						"Loaded models in %.2fms (%s start: %d cooked, %d from cache).",
+						milliseconds,
+						cache.get_misses_count() > 0 ? "cold" : "warm",
+						cache.get_misses_count(),
+						cache.get_hits_count()
+					);
+				};
+			}
+		);
+	}
 }
 
 void GameInstance::init()
@@ -61,12 +210,24 @@ void GameInstance::init()
 	OpenGLRenderBatch* render_batch = get_render_batch();
 	render_batch->set_background_color( Color::from_0x( 0x00000000 ) );
 
-    // Load scene
+    // Load scene once its assets are ready
+	_asset_loader->wait();
+	_asset_loader.reset();
 	engine.create_scene<GameScene>( this );
 }
 
 void GameInstance::release()
-{}
+{
+	ModelLods::clear();
+}
+
+MatchResources GameInstance::get_match_resources() const
+{
+	MatchResources resources {};
+	resources.job_system = _job_system.get();
+	resources.explosion_curves = _explosion_curves.get();
+	return resources;
+}
 
 GameInfos GameInstance::get_infos() const
 {
@@ -5,6 +5,13 @@
 
 #include "suprengine/input/input-manager.h"
 
+#include <spaceship/utils/curve-table.h>
+#include <spaceship/utils/job-system.h>
+
+#include "asset-loader.h"
+#include "launch-settings.h"
+#include "match-setup.h"
+
 namespace spaceship
 {
 	using namespace suprengine;
@@ -12,7 +19,15 @@ namespace spaceship
 	class GameInstance : public Game<OpenGLRenderBatch>
 	{
 	public:
+		GameInstance();
+		explicit GameInstance( const GameLaunchSettings& launch_settings );
+
 		void load_assets() override;
+		/*
+		 * Starts loading all assets and returns the handle to wait for, assets
+		 * loaded on workers are only available once it is ready.
+		 */
+		SharedPtr<AssetLoader> load_assets_async();
 
 		void init() override;
 
@@ -20,7 +35,34 @@ namespace spaceship
 
 		GameInfos get_infos() const override;
 
+		const GameLaunchSettings& get_launch_settings() const { return _launch_settings; }
+		/*
+		 * Returns the resources shared by matches, only complete once assets are loaded.
+		 */
+		MatchResources get_match_resources() const;
+
+	public:
+		/*
+		 * Settings used by instances created by the engine, which can't forward
+		 * constructor arguments. Must be assigned before running the engine.
+		 */
+		static GameLaunchSettings default_launch_settings;
+
+	private:
+		//  Folder of cooked models, relative to the working directory
+		static constexpr const char* MESH_CACHE_PATH = "cache/models/";
+
 	private:
 		void setup_input_actions(InputManager* inputs);
+		void _load_models( AssetLoader& loader );
+
+	private:
+		GameLaunchSettings _launch_settings = default_launch_settings;
+
+		SharedPtr<AssetLoader> _asset_loader;
+		//  Runs simulation jobs of the game scene
+		std::unique_ptr<JobSystem> _job_system;
+		//  Baked once curves are loaded, read by all matches
+		std::unique_ptr<CurveTable> _explosion_curves;
 	};
 }
@@ -0,0 +1,160 @@
+#include "headless-runner.h"
+
+#include <chrono>
+#include <fstream>
+
+#include <spaceship/game-instance.h>
+#include <spaceship/match-setup.h>
+#include <spaceship/entities/explosion-effect.h>
+#include <spaceship/entities/guided-missile.h>
+#include <spaceship/utils/entity-pool.hpp>
+#include <spaceship/utils/fixed-timestep.h>
+#include <spaceship/utils/match-stats.h>
+#include <spaceship/utils/simulation-checksum.h>
+#include <spaceship/world.h>
+
+using namespace spaceship;
+
+HeadlessRunner::HeadlessRunner( const GameLaunchSettings& settings )
+	: _settings( settings )
+{
+	_settings.is_headless = true;
+}
+
+int HeadlessRunner::run()
+{
+	using clock = std::chrono::steady_clock;
+
+	const bool should_write_checksums = !_settings.checksum_path.empty();
+
+	std::ofstream checksum_file;
+	if ( should_write_checksums )
+	{
+		checksum_file.open( _settings.checksum_path );
+		if ( !checksum_file.is_open() )
+		{
+			Logger::error( "Failed to open checksum file '%s'.", _settings.checksum_path.c_str() );
+			return 1;
+		}
+	}
+
+	// Load assets and the match without going through the engine's window loop
+	GameInstance game_instance( _settings );
+	game_instance.load_assets_async()->wait();
+	const std::unique_ptr<World> world_owner = MatchSetup::create_world( _settings, game_instance.get_match_resources() );
+	World& world = *world_owner;
+
+	const bool should_write_stats = !_settings.stats_path.empty();
+	MatchStatsRecorder stats_recorder {};
+	if ( should_write_stats )
+	{
+		stats_recorder.bind( world );
+	}
+
+	Logger::info(
+		"Running headless simulation for %d ticks with %d AIs.",
+		_settings.headless_ticks,
+		_settings.headless_ai_count
+	);
+
+	const float frame_time = _get_frame_time();
+	const uint64 ticks_count = static_cast<uint64>( math::max( 0, _settings.headless_ticks ) );
+
+	FixedTimestep timestep( TICK_DELTA_TIME, MAX_TICKS_PER_FRAME );
+	SimulationChecksum checksum {};
+
+	const clock::time_point start_time = clock::now();
+	while ( timestep.get_tick_count() < ticks_count )
+	{
+		timestep.accumulate( frame_time );
+		while ( timestep.get_tick_count() < ticks_count && timestep.consume_step() )
+		{
+			world.update( timestep.get_step_time() );
+
+			if ( should_write_stats )
+			{
+				stats_recorder.update( timestep.get_step_time() );
+			}
+
+			if ( should_write_checksums )
+			{
+				checksum_file << timestep.get_tick_count() << ' '
+					<< std::hex << checksum.compute_tick( world ) << std::dec << '\n';
+			}
+		}
+	}
+	const clock::time_point end_time = clock::now();
+
+	// Report
+	const double seconds = std::chrono::duration<double>( end_time - start_time ).count();
+	const double ticks_per_second = seconds > 0.0
+		? static_cast<double>( _settings.headless_ticks ) / seconds
+		: 0.0;
+	Logger::info(
+		"Simulated %d ticks in %.3fs: %.1f ticks/s (%.3fms/tick, %.1fx real-time).",
+		_settings.headless_ticks,
+		seconds,
+		ticks_per_second,
+		seconds * 1000.0 / math::max( 1, _settings.headless_ticks ),
+		ticks_per_second * TICK_DELTA_TIME
+	);
+	Logger::info(
+		"Pools created %d missiles and %d explosions.",
+		world.get_missiles_pool().get_created_count(),
+		world.get_explosions_pool().get_created_count()
+	);
+	if ( should_write_stats )
+	{
+		std::ofstream stats_file( _settings.stats_path );
+		if ( !stats_file.is_open() )
+		{
+			Logger::error( "Failed to open stats file '%s'.", _settings.stats_path.c_str() );
+			game_instance.release();
+			return 1;
+		}
+
+		MatchStatsRecorder::write_header( stats_file );
+		stats_recorder.write_rows( stats_file, world.get_seed() );
+	}
+	if ( should_write_checksums )
+	{
+		Logger::info( "Final simulation checksum: %016llx.", static_cast<unsigned long long>( checksum.get_value() ) );
+	}
+
+	game_instance.release();
+	return 0;
+}
+
+float HeadlessRunner::_get_frame_time() const
+{
+	// Without emulated frame time, each frame advances exactly one tick
+	if ( _settings.headless_frame_time <= 0.0f ) return TICK_DELTA_TIME;
+
+	// Time above the ticks a frame can simulate would be dropped
+	const float max_frame_time = TICK_DELTA_TIME * static_cast<float>( MAX_TICKS_PER_FRAME );
+	if ( _settings.headless_frame_time > max_frame_time )
+	{
+		Logger::warning(
+			"Frame time of %.4fs exceeds the %d ticks simulated per frame, clamping it to %.4fs.",
+			_settings.headless_frame_time,
+			MAX_TICKS_PER_FRAME,
+			max_frame_time
+		);
+		return max_frame_time;
+	}
+
+	// Frames too short to change the accumulated time would never advance a tick
+	const float min_frame_time = TICK_DELTA_TIME / static_cast<float>( MAX_FRAMES_PER_TICK );
+	if ( _settings.headless_frame_time < min_frame_time )
+	{
+		Logger::warning(
+			"Frame time of %gs is below %d frames per tick, clamping it to %gs.",
+			_settings.headless_frame_time,
+			MAX_FRAMES_PER_TICK,
+			min_frame_time
+		);
+		return min_frame_time;
+	}
+
+	return _settings.headless_frame_time;
+}
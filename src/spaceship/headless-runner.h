@@ -0,0 +1,36 @@
+#pragma once
+
+#include "launch-settings.h"
+
+namespace spaceship
+{
+	/*
+	 * Drives a match world without window, render batch nor inputs, advancing
+	 * ticks as fast as the CPU allows. Used to measure the simulation cost apart
+	 * from rendering.
+	 *
+	 * Ticks always have a fixed delta time: emulated frame times are accumulated
+	 * and split into fixed ticks, so the outcome doesn't depend on the frame rate.
+	 */
+	class HeadlessRunner
+	{
+	public:
+		explicit HeadlessRunner( const GameLaunchSettings& settings );
+
+		int run();
+
+	private:
+		//  Delta time given to each tick
+		const float TICK_DELTA_TIME = 1.0f / 60.0f;
+		//  Maximum ticks simulated for a single emulated frame
+		const int MAX_TICKS_PER_FRAME = 8;
+		//  Maximum emulated frames per tick, shorter frame times are lost in the accumulator precision
+		const int MAX_FRAMES_PER_TICK = 1000;
+
+	private:
+		float _get_frame_time() const;
+
+	private:
+		GameLaunchSettings _settings;
+	};
+}
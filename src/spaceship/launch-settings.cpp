@@ -0,0 +1,84 @@
+#include "launch-settings.h"
+
+#include <cstdlib>
+#include <string_view>
+
+#include <suprengine/utils/logger.h>
+
+using namespace spaceship;
+
+GameLaunchSettings GameLaunchSettings::from_arguments( const int arg_count, char** args )
+{
+	GameLaunchSettings settings {};
+
+	// Skip the executable path
+	for ( int i = 1; i < arg_count; i++ )
+	{
+		const std::string_view arg = args[i];
+		const bool has_value = i + 1 < arg_count;
+
+		if ( arg == "--headless" )
+		{
+			settings.is_headless = true;
+		}
+		else if ( arg == "--skip-models" )
+		{
+			settings.should_skip_models = true;
+		}
+		else if ( arg == "--no-mesh-cache" )
+		{
+			settings.use_mesh_cache = false;
+		}
+		else if ( arg == "--no-render-thread" )
+		{
+			settings.use_render_thread = false;
+		}
+		else if ( arg == "--ticks" && has_value )
+		{
+			settings.headless_ticks = std::atoi( args[++i] );
+		}
+		else if ( arg == "--ai-count" && has_value )
+		{
+			settings.headless_ai_count = std::atoi( args[++i] );
+		}
+		else if ( arg == "--asteroids" && has_value )
+		{
+			settings.asteroid_count = std::atoi( args[++i] );
+		}
+		else if ( arg == "--frame-time" && has_value )
+		{
+			settings.headless_frame_time = static_cast<float>( std::atof( args[++i] ) );
+		}
+		else if ( arg == "--seed" && has_value )
+		{
+			settings.is_seed_fixed = true;
+			settings.seed = static_cast<uint32>( std::strtoul( args[++i], nullptr, 10 ) );
+		}
+		else if ( arg == "--checksum-file" && has_value )
+		{
+			settings.checksum_path = args[++i];
+		}
+		else if ( arg == "--stats-file" && has_value )
+		{
+			settings.stats_path = args[++i];
+		}
+		else if ( arg == "--curve-resolution" && has_value )
+		{
+			settings.curve_table_resolution = std::atoi( args[++i] );
+		}
+		else if ( arg == "--job-threads" && has_value )
+		{
+			settings.job_threads_count = std::atoi( args[++i] );
+		}
+		else if ( arg == "--ai-budget" && has_value )
+		{
+			settings.ai_update_budget_us = static_cast<float>( std::atof( args[++i] ) );
+		}
+		else
+		{
+			Logger::warning( "Unknown command line argument '%s', ignoring it.", args[i] );
+		}
+	}
+
+	return settings;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <string>
+
+#include <suprengine/utils/memory.h>
+
+namespace spaceship
+{
+	using namespace suprengine;
+
+	/*
+	 * Settings parsed from the command line, available before the engine starts.
+	 *
+	 * Supported arguments:
+	 * --headless              Run the simulation without window, renderer nor models.
+	 * --skip-models           Don't load models, implied by '--headless'.
+	 * --no-mesh-cache         Always parse models sources instead of using cooked files.
+	 * --no-render-thread      Cull draws on the main thread, without a frame of latency.
+	 * --ticks <count>         Number of ticks to simulate in headless mode.
+	 * --ai-count <count>      Number of AI spaceships to spawn in headless mode.
+	 * --asteroids <count>     Number of asteroids to spawn.
+	 * --seed <seed>           Seed of the game scene, random if unspecified.
+	 * --frame-time <seconds>  Emulated frame time in headless mode, split into fixed ticks.
+	 * --checksum-file <path>  Write the simulation checksum of each tick to a file.
+	 * --stats-file <path>     Write the spaceships stats of the headless match to a CSV file.
+	 * --curve-resolution <n>  Number of samples baked per curve.
+	 * --job-threads <count>   Number of job worker threads, zero to update serially.
+	 * --ai-budget <us>        Maximum duration of AI planning per frame, in microseconds.
+	 */
+	struct GameLaunchSettings
+	{
+		bool is_headless = false;
+		bool should_skip_models = false;
+		bool use_mesh_cache = true;
+		bool use_render_thread = true;
+
+		int headless_ticks = 10000;
+		int headless_ai_count = 20;
+		int asteroid_count = 32;
+		//  When zero, each headless frame advances exactly one tick
+		float headless_frame_time = 0.0f;
+
+		bool is_seed_fixed = false;
+		uint32 seed = 0;
+
+		std::string checksum_path {};
+		std::string stats_path {};
+
+		int curve_table_resolution = 256;
+
+		//  When negative, one thread per core is used, except for the main thread
+		int job_threads_count = -1;
+
+		//  When zero, far AIs are only time-sliced by distance, keeping the simulation deterministic
+		float ai_update_budget_us = 0.0f;
+
+		static GameLaunchSettings from_arguments( int arg_count, char** args );
+	};
+}
@@ -1,11 +1,25 @@
 #include <suprengine/core/engine.h>
 
 #include "game-instance.h"
+#include "headless-runner.h"
+#include "launch-settings.h"
 
 using namespace suprengine;
 
 int main( int arg_count, char** args )
 {
+	const spaceship::GameLaunchSettings settings =
+		spaceship::GameLaunchSettings::from_arguments( arg_count, args );
+
+	// Simulate without window nor renderer
+	if ( settings.is_headless )
+	{
+		spaceship::HeadlessRunner runner( settings );
+		return runner.run();
+	}
+
+	spaceship::GameInstance::default_launch_settings = settings;
+
 	auto& engine = Engine::instance();
 	return engine.run<spaceship::GameInstance>();
-}
\ No newline at end of file
+}
@@ -0,0 +1,125 @@
+#include "match-setup.h"
+
+#include <ctime>
+
+#include <spaceship/components/instanced-renderer.h>
+#include <spaceship/components/stylized-model-renderer.h>
+#include <spaceship/entities/ai-spaceship-controller.h>
+#include <spaceship/entities/explosion-effect.h>
+#include <spaceship/entities/guided-missile.h>
+#include <spaceship/entities/spaceship.h>
+#include <spaceship/physics/collision-broadphase.h>
+#include <spaceship/systems/asteroid-field.h>
+#include <spaceship/systems/projectile-system.h>
+#include <spaceship/utils/entity-pool.hpp>
+#include <spaceship/world.h>
+
+#include <suprengine/core/assets.h>
+
+using namespace spaceship;
+
+std::unique_ptr<World> MatchSetup::create_world( const GameLaunchSettings& settings, const MatchResources& resources )
+{
+	const uint32 seed = settings.is_seed_fixed
+		? settings.seed
+		: static_cast<uint32>( std::time( nullptr ) );
+
+	// Entities must be tracked from their creation for the checksum to be complete
+	std::unique_ptr<World> world = std::make_unique<World>( seed );
+	world->is_checksum_tracking_enabled = !settings.checksum_path.empty();
+	world->ai_scheduler.budget_us = settings.ai_update_budget_us;
+	world->job_system = resources.job_system;
+	world->explosion_curves = resources.explosion_curves;
+
+	// Setup systems, the broadphase is created first to be built before any query
+	world->create_entity<CollisionBroadphase>();
+	world->create_entity<ProjectileSystem>();
+
+	if ( !settings.is_headless )
+	{
+		// Setup instanced rendering, models drawn with the stylized shader are batched.
+		// Headless simulation never renders, so it doesn't need a render thread either.
+		const SharedPtr<Entity> renderer_owner = world->create_entity<Entity>();
+		renderer_owner->create_component<InstancedRenderer>( settings.use_render_thread );
+
+		// Setup planet, only seen and never collided with
+		const SharedPtr<Entity> planet = world->create_entity<Entity>();
+		planet->transform->location = Vec3 { 2000.0f, 500.0f, 30.0f };
+		planet->transform->rotation = Quaternion( DegAngles { -6.0f, 0.0f, 12.0f } );
+		planet->transform->scale = Vec3( 10.0f );
+		const SharedPtr<StylizedModelRenderer> planet_renderer = planet->create_component<StylizedModelRenderer>(
+			Assets::get_model( "planet-ring" ),
+			Color::from_0x( 0x1c6cF0FF )
+		);
+		// The planet sphere fills the bounds height, only the ring is wider
+		planet_renderer->occluder_ratio = 0.95f;
+	}
+
+	// Setup pools
+	world->get_missiles_pool().prewarm( GuidedMissile::POOL_PREWARM_COUNT );
+	world->get_explosions_pool().prewarm( ExplosionEffect::POOL_PREWARM_COUNT );
+
+	// Spawn asteroids
+	constexpr Vec3 ASTEROIDS_LOCATION { 500.0f, 100.0f, 50.0f };
+
+	RandomStream& random = world->random;
+	const SharedPtr<AsteroidField> asteroid_field = world->create_entity<AsteroidField>();
+	for ( int i = 0; i < settings.asteroid_count; i++ )
+	{
+		AsteroidSpawnInfo info {};
+		info.location = ASTEROIDS_LOCATION + random.generate_location(
+			-300.0f, -300.0f, -300.0f,
+			300.0f, 300.0f, 300.0f
+		);
+		info.rotation = Quaternion::look_at( random.generate_direction(), Vec3::up );
+		info.scale = random.generate_scale( 4.0f, 30.0f );
+		info.linear_direction = Vec3::right * 2.0f * random.generate( 0.8f, 1.2f );
+		asteroid_field->spawn( info );
+	}
+
+	// Headless simulation has no inputs nor cameras, only AIs are spawned
+	if ( settings.is_headless )
+	{
+		spawn_ai_spaceships( *world, settings.headless_ai_count );
+	}
+
+	return world;
+}
+
+void MatchSetup::spawn_ai_spaceships( World& world, const int count )
+{
+	std::vector<SharedPtr<Spaceship>> potential_targets;
+	std::vector<SharedPtr<AISpaceshipController>> controllers;
+
+	for ( int i = 0; i < count; i++ )
+	{
+		auto spaceship = world.create_entity<Spaceship>();
+		spaceship->set_color( world.random.generate_color() );
+		spaceship->transform->location = Vec3 
+		{ 
+			100.0f + static_cast<float>( i ) * 50.0f,
+			0.0f,
+			0.0f
+		};
+		potential_targets.push_back( spaceship );
+
+		auto controller = world.create_entity<AISpaceshipController>();
+		controller->possess( spaceship );
+		controllers.push_back( controller );
+	}
+
+	// A lone spaceship has nothing to chase, the targeting service handles newcomers
+	if ( count < 2 ) return;
+
+	// Sattolo's shuffle leaves no spaceship at its own index, so no AI chases itself.
+	// Shuffle with the seeded generator to keep the simulation deterministic
+	for ( int i = count - 1; i > 0; i-- )
+	{
+		std::swap( potential_targets[i], potential_targets[world.random.generate( 0, i - 1 )] );
+	}
+
+	for ( int i = 0; i < count; i++ )
+	{
+		controllers[i]->wk_target = potential_targets[i];
+	}
+}
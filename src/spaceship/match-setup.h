@@ -0,0 +1,42 @@
+#pragma once
+
+#include <memory>
+
+#include "launch-settings.h"
+
+namespace spaceship
+{
+	class CurveTable;
+	class JobSystem;
+	class World;
+
+	/*
+	 * Resources shared by all matches of the process, created once assets are
+	 * loaded and never modified while matches are running.
+	 */
+	struct MatchResources
+	{
+		//  Runs the jobs of the simulation, matches are updated serially when null
+		JobSystem* job_system = nullptr;
+		const CurveTable* explosion_curves = nullptr;
+	};
+
+	/*
+	 * Creates the world of a match: systems, pools, scenery and asteroids, and AI
+	 * spaceships in headless mode. Players are left to the game scene, since they
+	 * need inputs and cameras.
+	 *
+	 * Only touches the created world, so matches can be set up on any thread.
+	 */
+	class MatchSetup
+	{
+	public:
+		static std::unique_ptr<World> create_world( const GameLaunchSettings& settings, const MatchResources& resources );
+
+		/*
+		 * Spawns AI spaceships, each one chasing another spaceship picked at random,
+		 * never its own.
+		 */
+		static void spawn_ai_spaceships( World& world, int count );
+	};
+}
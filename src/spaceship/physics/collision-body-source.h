@@ -0,0 +1,39 @@
+#pragma once
+
+#include <vector>
+
+#include <spaceship/components/health-component.h>
+
+namespace spaceship
+{
+	using namespace suprengine;
+
+	struct CollisionSphere
+	{
+		Vec3 center;
+		float radius;
+
+		//  Index of the body inside its source
+		int body_index;
+	};
+
+	/*
+	 * Provides bodies which are not backed by engine colliders to the broadphase,
+	 * such as the asteroids of a field. They are tested as spheres and damaged
+	 * through their source.
+	 */
+	class CollisionBodySource
+	{
+	public:
+		virtual ~CollisionBodySource() = default;
+
+		/*
+		 * Appends the spheres of all collidable bodies. Called by the broadphase
+		 * before each build, which is the only moment sources may re-order their
+		 * bodies: body indices must stay valid until the next gathering.
+		 */
+		virtual void gather_collision_spheres( std::vector<CollisionSphere>& spheres ) = 0;
+
+		virtual DamageResult damage_body( int body_index, const DamageInfo& info ) = 0;
+	};
+}
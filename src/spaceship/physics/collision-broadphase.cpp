@@ -0,0 +1,353 @@
+#include "collision-broadphase.h"
+
+#include <algorithm>
+
+#include <spaceship/utils/job-system.h>
+
+#include <suprengine/components/colliders/box-collider.h>
+
+using namespace spaceship;
+
+
+static float get_axis( const Vec3& vector, const int axis )
+{
+	switch ( axis )
+	{
+		case 0:
+			return vector.x;
+		case 1:
+			return vector.y;
+		default:
+			return vector.z;
+	}
+}
+
+void CollisionBroadphase::setup()
+{
+	_world->wk_broadphase = as<CollisionBroadphase>();
+}
+
+void CollisionBroadphase::update_this( float dt )
+{
+	rebuild();
+}
+
+void CollisionBroadphase::rebuild()
+{
+	_proxies.clear();
+	_nodes.clear();
+	_body_sources.clear();
+
+	// Gather proxies and forget about destroyed colliders
+	std::erase_if( _world->registered_colliders,
+		[this]( const World::RegisteredCollider& registered )
+		{
+			const SharedPtr<Collider> collider = registered.collider.lock();
+			if ( collider == nullptr ) return true;
+			if ( !collider->is_active ) return false;
+
+			const SharedPtr<Entity> owner = collider->get_owner();
+			if ( owner == nullptr ) return true;
+
+			const Vec3& scale = collider->transform->scale;
+			const float max_scale = math::max( math::abs( scale.x ), math::max( math::abs( scale.y ), math::abs( scale.z ) ) );
+			const Vec3 extents( registered.bounding_radius * max_scale + BOUNDS_MARGIN );
+			const Vec3& center = collider->transform->location;
+
+			_proxies.push_back(
+				Proxy {
+					.min = center - extents,
+					.max = center + extents,
+					.center = center,
+					.entity_id = owner->get_unique_id(),
+					.collider = collider,
+					.body_source = nullptr,
+					.body_index = -1,
+					.radius = 0.0f,
+				}
+			);
+			return false;
+		}
+	);
+
+	// Gather bodies of sources
+	std::erase_if( _world->registered_body_sources,
+		[this]( const WeakPtr<CollisionBodySource>& wk_source )
+		{
+			SharedPtr<CollisionBodySource> source = wk_source.lock();
+			if ( source == nullptr ) return true;
+
+			_spheres_buffer.clear();
+			source->gather_collision_spheres( _spheres_buffer );
+
+			for ( const CollisionSphere& sphere : _spheres_buffer )
+			{
+				const Vec3 extents( sphere.radius + BOUNDS_MARGIN );
+				_proxies.push_back(
+					Proxy {
+						.min = sphere.center - extents,
+						.max = sphere.center + extents,
+						.center = sphere.center,
+						.entity_id = SegmentQuery::INVALID_ENTITY_ID,
+						.collider = {},
+						.body_source = source.get(),
+						.body_index = sphere.body_index,
+						.radius = sphere.radius,
+					}
+				);
+			}
+
+			_body_sources.push_back( std::move( source ) );
+			return false;
+		}
+	);
+	if ( _proxies.empty() ) return;
+
+	_nodes.reserve( _proxies.size() * 2 / MAX_LEAF_PROXIES + 1 );
+	_build_node( 0, static_cast<int>( _proxies.size() ) );
+}
+
+void CollisionBroadphase::query_segments(
+	const std::vector<SegmentQuery>& queries,
+	std::vector<SegmentQueryResult>& results
+) const
+{
+	results.resize( queries.size() );
+
+	// Queries only read the hierarchy and write their own result
+	JobSystem::run_parallel( _world->job_system, static_cast<int>( queries.size() ), QUERY_CHUNK_SIZE,
+		[this, &queries, &results]( int, const int begin, const int end )
+		{
+			for ( int i = begin; i < end; i++ )
+			{
+				_query( queries[i], &results[i] );
+			}
+		}
+	);
+}
+
+bool CollisionBroadphase::query_segment( const SegmentQuery& query, SegmentQueryResult* result ) const
+{
+	return _query( query, result );
+}
+
+void CollisionBroadphase::register_collider(
+	World& world,
+	const SharedPtr<Collider>& collider,
+	const float bounding_radius
+)
+{
+	world.registered_colliders.push_back( World::RegisteredCollider { collider, bounding_radius } );
+}
+
+void CollisionBroadphase::register_body_source( World& world, const SharedPtr<CollisionBodySource>& source )
+{
+	world.registered_body_sources.push_back( source );
+}
+
+DamageResult CollisionBroadphase::damage( const SegmentQueryResult& result, const DamageInfo& info )
+{
+	if ( result.body_source != nullptr )
+	{
+		return result.body_source->damage_body( result.body_index, info );
+	}
+
+	const SharedPtr<Entity> entity = result.hit.collider->get_owner();
+	if ( const SharedPtr<HealthComponent> health = entity->find_component<HealthComponent>() )
+	{
+		return health->damage( info );
+	}
+
+	return DamageResult( info );
+}
+
+int CollisionBroadphase::_build_node( const int first, const int count )
+{
+	const int node_index = static_cast<int>( _nodes.size() );
+	_nodes.push_back( Node {} );
+
+	// Compute bounds of proxies and of their centers
+	Vec3 min = _proxies[first].min;
+	Vec3 max = _proxies[first].max;
+	Vec3 center_min = _proxies[first].center;
+	Vec3 center_max = _proxies[first].center;
+	for ( int i = first + 1; i < first + count; i++ )
+	{
+		const Proxy& proxy = _proxies[i];
+		min = Vec3::min( min, proxy.min );
+		max = Vec3::max( max, proxy.max );
+		center_min = Vec3::min( center_min, proxy.center );
+		center_max = Vec3::max( center_max, proxy.center );
+	}
+
+	// Create leaf
+	if ( count <= MAX_LEAF_PROXIES )
+	{
+		_nodes[node_index] = Node { min, max, first, -1, count };
+		return node_index;
+	}
+
+	// Split at the median of the largest axis
+	const Vec3 center_size = center_max - center_min;
+	int axis = 0;
+	if ( center_size.y > center_size.x ) axis = 1;
+	if ( center_size.z > get_axis( center_size, axis ) ) axis = 2;
+
+	const int half_count = count / 2;
+	std::nth_element(
+		_proxies.begin() + first,
+		_proxies.begin() + first + half_count,
+		_proxies.begin() + first + count,
+		[axis]( const Proxy& lhs, const Proxy& rhs )
+		{
+			return get_axis( lhs.center, axis ) < get_axis( rhs.center, axis );
+		}
+	);
+
+	// Children creation can re-allocate nodes, don't keep any reference
+	const int left = _build_node( first, half_count );
+	const int right = _build_node( first + half_count, count - half_count );
+	_nodes[node_index] = Node { min, max, left, right, 0 };
+	return node_index;
+}
+
+bool CollisionBroadphase::_query( const SegmentQuery& query, SegmentQueryResult* result ) const
+{
+	*result = SegmentQueryResult {};
+	if ( _nodes.empty() ) return false;
+
+	const Vec3& origin = query.ray.origin;
+	const Vec3& direction = query.ray.direction;
+	const Vec3 inverse_direction {
+		1.0f / direction.x,
+		1.0f / direction.y,
+		1.0f / direction.z,
+	};
+
+	float best_distance = query.ray.distance;
+
+	// Balanced tree, its depth is logarithmic to the proxies count
+	int stack[64];
+	int stack_size = 0;
+	stack[stack_size++] = 0;
+
+	while ( stack_size > 0 )
+	{
+		const Node& node = _nodes[stack[--stack_size]];
+		if ( !_intersect_bounds( origin, inverse_direction, node.min, node.max, best_distance ) ) continue;
+
+		// Inner node
+		if ( node.count == 0 )
+		{
+			stack[stack_size++] = node.right;
+			stack[stack_size++] = node.first;
+			continue;
+		}
+
+		// Narrow-phase on leaf proxies
+		for ( int i = node.first; i < node.first + node.count; i++ )
+		{
+			const Proxy& proxy = _proxies[i];
+			if ( proxy.entity_id == query.ignored_entity_id ) continue;
+
+			RayHit candidate {};
+			float distance = 0.0f;
+
+			// Source bodies are spheres
+			if ( proxy.body_source != nullptr )
+			{
+				if ( !_raycast_sphere( query, proxy.center, proxy.radius, best_distance, &candidate, &distance ) ) continue;
+			}
+			else
+			{
+				const SharedPtr<Collider> collider = proxy.collider.lock();
+				if ( collider == nullptr || !collider->is_active ) continue;
+
+				// Shorten the ray to the best hit so far
+				const Ray ray( origin, direction, best_distance );
+				if ( !collider->raycast( ray, &candidate, query.params ) ) continue;
+
+				distance = ( candidate.point - origin ).length();
+				if ( distance > best_distance ) continue;
+			}
+
+			best_distance = distance;
+			result->has_hit = true;
+			result->hit = candidate;
+			result->entity_id = proxy.entity_id;
+			result->body_source = proxy.body_source;
+			result->body_index = proxy.body_index;
+		}
+	}
+
+	return result->has_hit;
+}
+
+bool CollisionBroadphase::_raycast_sphere(
+	const SegmentQuery& query,
+	const Vec3& center,
+	const float radius,
+	const float max_distance,
+	RayHit* hit,
+	float* distance
+)
+{
+	const Vec3& origin = query.ray.origin;
+	const Vec3& direction = query.ray.direction;
+
+	const Vec3 offset = origin - center;
+	const float b = Vec3::dot( offset, direction );
+	const float c = offset.length_sqr() - radius * radius;
+
+	// Starting inside the sphere
+	if ( c <= 0.0f )
+	{
+		if ( !query.params.can_hit_from_origin ) return false;
+
+		*distance = 0.0f;
+		hit->point = origin;
+		hit->normal = -direction;
+		return true;
+	}
+
+	// Pointing away or missing the sphere
+	if ( b > 0.0f ) return false;
+
+	const float discriminant = b * b - c;
+	if ( discriminant < 0.0f ) return false;
+
+	const float t = -b - math::sqrt( discriminant );
+	if ( t > max_distance ) return false;
+
+	*distance = t;
+	hit->point = origin + direction * t;
+	hit->normal = ( hit->point - center ) * ( 1.0f / radius );
+	return true;
+}
+
+bool CollisionBroadphase::_intersect_bounds(
+	const Vec3& origin,
+	const Vec3& inverse_direction,
+	const Vec3& min,
+	const Vec3& max,
+	const float max_distance
+)
+{
+	// Slab test
+	const float tx1 = ( min.x - origin.x ) * inverse_direction.x;
+	const float tx2 = ( max.x - origin.x ) * inverse_direction.x;
+	float t_min = math::min( tx1, tx2 );
+	float t_max = math::max( tx1, tx2 );
+
+	const float ty1 = ( min.y - origin.y ) * inverse_direction.y;
+	const float ty2 = ( max.y - origin.y ) * inverse_direction.y;
+	t_min = math::max( t_min, math::min( ty1, ty2 ) );
+	t_max = math::min( t_max, math::max( ty1, ty2 ) );
+
+	const float tz1 = ( min.z - origin.z ) * inverse_direction.z;
+	const float tz2 = ( max.z - origin.z ) * inverse_direction.z;
+	t_min = math::max( t_min, math::min( tz1, tz2 ) );
+	t_max = math::min( t_max, math::max( tz1, tz2 ) );
+
+	return t_max >= math::max( t_min, 0.0f ) && t_min <= max_distance;
+}
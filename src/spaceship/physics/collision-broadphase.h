@@ -0,0 +1,136 @@
+#pragma once
+
+#include <vector>
+
+#include <spaceship/physics/collision-body-source.h>
+#include <spaceship/physics/segment-query.h>
+#include <spaceship/world.h>
+
+#include <suprengine/core/entity.h>
+#include <suprengine/utils/ray.h>
+
+namespace suprengine
+{
+	class Collider;
+}
+
+namespace spaceship
+{
+	using namespace suprengine;
+
+	/*
+	 * Bounding volume hierarchy over registered colliders and bodies of registered
+	 * sources, built once per frame,
+	 * answering batches of segment queries in roughly O(N log M) instead of testing
+	 * every collider for every segment.
+	 *
+	 * Bounds are fattened by a margin since bodies keep moving after the build,
+	 * narrow-phase tests always use the colliders' current state.
+	 */
+	class CollisionBroadphase : public WorldEntity
+	{
+	public:
+		void setup() override;
+		void update_this( float dt ) override;
+
+		/*
+		 * Rebuilds the hierarchy from the registered colliders.
+		 * Automatically called once per frame.
+		 */
+		void rebuild();
+
+		/*
+		 * Finds the closest hit of each query. Results are written at the same
+		 * index than their query. Queries are answered in jobs.
+		 */
+		void query_segments(
+			const std::vector<SegmentQuery>& queries,
+			std::vector<SegmentQueryResult>& results
+		) const;
+		bool query_segment( const SegmentQuery& query, SegmentQueryResult* result ) const;
+
+		int get_proxies_count() const { return static_cast<int>( _proxies.size() ); }
+
+		/*
+		 * Registers a collider to be part of the next builds of the world's
+		 * broadphase. The bounding radius is scaled by the owner's transform.
+		 * Colliders are automatically unregistered when destroyed.
+		 */
+		static void register_collider( World& world, const SharedPtr<Collider>& collider, float bounding_radius );
+		/*
+		 * Registers a source of bodies to be part of the next builds of the world's
+		 * broadphase. Sources are automatically unregistered when destroyed.
+		 */
+		static void register_body_source( World& world, const SharedPtr<CollisionBodySource>& source );
+
+		/*
+		 * Damages the entity or the source body hit by a query. The entity must have
+		 * a health component for the damage to be valid.
+		 */
+		static DamageResult damage( const SegmentQueryResult& result, const DamageInfo& info );
+
+	private:
+		//  Margin added to the bounds of each collider
+		const float BOUNDS_MARGIN = 4.0f;
+		//  Maximum number of proxies stored in a leaf node
+		const int MAX_LEAF_PROXIES = 4;
+		//  Segment queries answered per job
+		static constexpr int QUERY_CHUNK_SIZE = 64;
+
+	private:
+		struct Proxy
+		{
+			Vec3 min, max;
+			Vec3 center;
+
+			uint32 entity_id;
+			WeakPtr<Collider> collider;
+
+			//  Source body, tested as a sphere, when there is no collider
+			CollisionBodySource* body_source;
+			int body_index;
+			float radius;
+		};
+
+		struct Node
+		{
+			Vec3 min, max;
+
+			//  Index of the left child node, or of the first proxy for leaves
+			int first;
+			//  Index of the right child node, unused for leaves
+			int right;
+			//  Number of proxies for leaves, zero for inner nodes
+			int count;
+		};
+
+	private:
+		int _build_node( int first, int count );
+		bool _query( const SegmentQuery& query, SegmentQueryResult* result ) const;
+
+		static bool _raycast_sphere(
+			const SegmentQuery& query,
+			const Vec3& center,
+			float radius,
+			float max_distance,
+			RayHit* hit,
+			float* distance
+		);
+
+		static bool _intersect_bounds(
+			const Vec3& origin,
+			const Vec3& inverse_direction,
+			const Vec3& min,
+			const Vec3& max,
+			float max_distance
+		);
+
+	private:
+		std::vector<Proxy> _proxies;
+		std::vector<Node> _nodes;
+
+		//  Sources gathered in the last build, kept alive until the next one
+		std::vector<SharedPtr<CollisionBodySource>> _body_sources;
+		std::vector<CollisionSphere> _spheres_buffer;
+	};
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <suprengine/utils/ray.h>
+
+namespace spaceship
+{
+	using namespace suprengine;
+
+	class CollisionBodySource;
+
+	struct SegmentQuery
+	{
+		Ray ray {};
+		RayParams params {};
+
+		//  Unique ID of the entity whose colliders are ignored, usually the shooter
+		uint32 ignored_entity_id = INVALID_ENTITY_ID;
+
+		static constexpr uint32 INVALID_ENTITY_ID = ~0u;
+	};
+
+	struct SegmentQueryResult
+	{
+		bool has_hit = false;
+		//  Hit informations, the collider is null when a source body is hit
+		RayHit hit {};
+
+		//  Unique ID of the entity owning the hit collider, invalid for source bodies
+		uint32 entity_id = SegmentQuery::INVALID_ENTITY_ID;
+
+		CollisionBodySource* body_source = nullptr;
+		int body_index = -1;
+	};
+}
@@ -2,10 +2,10 @@
 
 #include "entities/player-spaceship-controller.h"
 #include "entities/spaceship.h"
+#include "world.h"
 
 #include "suprengine/core/engine.h"
 #include "suprengine/input/input-manager.h"
-#include "suprengine/utils/random.h"
 
 using namespace spaceship;
 
@@ -19,18 +19,18 @@ constexpr uint32 PLAYER_COLORS[PLAYER_COLORS_COUNT]
 	0x26B6A6FF, // Duck blue
 };
 
-PlayerManager::PlayerManager( InputManager& inputs )
-	: _inputs( inputs )
+PlayerManager::PlayerManager( World& world, InputManager& inputs )
+	: _world( world ), _inputs( inputs ),
+	  _next_color_id( world.random.generate( 0, PLAYER_COLORS_COUNT - 1 ) )
 {
 	_inputs.on_gamepad_connected.listen( &PlayerManager::on_gamepad_connected, this );
 	_inputs.on_gamepad_disconnected.listen( &PlayerManager::on_gamepad_disconnected, this );
 }
 
-static Color get_next_player_color()
+Color PlayerManager::_get_next_player_color()
 {
-	static int color_id = random::generate( 0, PLAYER_COLORS_COUNT - 1 );
-	const Color player_color = Color::from_0x( PLAYER_COLORS[color_id] );
-	color_id = ( color_id + 1 ) % PLAYER_COLORS_COUNT;
+	const Color player_color = Color::from_0x( PLAYER_COLORS[_next_color_id] );
+	_next_color_id = ( _next_color_id + 1 ) % PLAYER_COLORS_COUNT;
 
 	return player_color;
 }
@@ -50,10 +50,8 @@ SharedPtr<PlayerSpaceshipController> PlayerManager::create_player(
 	const int player_id = static_cast<int>(_controllers.size());
 	ASSERT( player_id < 4 );
 
-	Engine& engine = Engine::instance();
-
-	const SharedPtr<Spaceship> ship = engine.create_entity<Spaceship>();
-	ship->set_color( get_next_player_color() );
+	const SharedPtr<Spaceship> ship = _world.create_entity<Spaceship>();
+	ship->set_color( _get_next_player_color() );
 	ship->transform->location = location;
 	ship->transform->rotation = rotation;
 
@@ -63,7 +61,7 @@ SharedPtr<PlayerSpaceshipController> PlayerManager::create_player(
 	};
 
 	SharedPtr<PlayerSpaceshipController> controller =
-		engine.create_entity<PlayerSpaceshipController>( input_context );
+		_world.create_entity<PlayerSpaceshipController>( input_context );
 	controller->possess( ship );
 
 	Logger::info( "Player using gamepad %d has been created.", gamepad_id );
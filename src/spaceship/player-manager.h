@@ -17,11 +17,12 @@ namespace spaceship
 	using namespace suprengine;
 
 	class PlayerSpaceshipController;
+	class World;
 
 	class PlayerManager
 	{
 	public:
-		explicit PlayerManager( InputManager& inputs );
+		PlayerManager( World& world, InputManager& inputs );
 		~PlayerManager() = default;
 
 		SharedPtr<PlayerSpaceshipController> create_player(
@@ -36,14 +37,21 @@ namespace spaceship
 		void update_viewports();
 
 		[[nodiscard]] SharedPtr<Camera> get_camera( int player_id ) const;
+		[[nodiscard]] int get_players_count() const { return static_cast<int>( _controllers.size() ); }
 
 	private:
 		void on_gamepad_connected( int gamepad_id );
 		void on_gamepad_disconnected( int gamepad_id );
 
+		Color _get_next_player_color();
+
 	private:
 		std::vector<SharedPtr<PlayerSpaceshipController>> _controllers{};
 
+		World& _world;
 		InputManager& _inputs;
+
+		//  Cycles through the players colors from a random one
+		int _next_color_id = 0;
 	};
 }
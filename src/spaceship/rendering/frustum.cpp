@@ -0,0 +1,130 @@
+#include "frustum.h"
+
+#include <cmath>
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+	#include <emmintrin.h>
+	#define SPACESHIP_FRUSTUM_SSE
+#endif
+
+using namespace spaceship;
+
+Frustum Frustum::from_view_projection( const Mtx4& view_projection )
+{
+	const auto& mat = view_projection.mat;
+
+	// With row vectors, clip coordinates are dot products with the matrix columns
+	const auto get_column = [&mat]( const int column, float* out_values )
+	{
+		for ( int row = 0; row < 4; row++ )
+		{
+			out_values[row] = mat[row][column];
+		}
+	};
+
+	float x[4], y[4], z[4], w[4];
+	get_column( 0, x );
+	get_column( 1, y );
+	get_column( 2, z );
+	get_column( 3, w );
+
+	// Left, right, bottom, top, near and far planes
+	const float* axes[PLANES_COUNT / 2] { x, y, z };
+	Frustum frustum {};
+	for ( int i = 0; i < PLANES_COUNT; i++ )
+	{
+		const float* axis = axes[i / 2];
+		const float sign = i % 2 == 0 ? 1.0f : -1.0f;
+
+		const float a = w[0] + axis[0] * sign;
+		const float b = w[1] + axis[1] * sign;
+		const float c = w[2] + axis[2] * sign;
+		const float d = w[3] + axis[3] * sign;
+
+		// Normalize so distances are in world units
+		const float length = std::sqrt( a * a + b * b + c * c );
+		const float inverse_length = length > 0.0f ? 1.0f / length : 0.0f;
+
+		frustum._normals_x[i] = a * inverse_length;
+		frustum._normals_y[i] = b * inverse_length;
+		frustum._normals_z[i] = c * inverse_length;
+		frustum._distances[i] = d * inverse_length;
+	}
+
+	return frustum;
+}
+
+bool Frustum::intersects_sphere( const Vec3& center, const float radius ) const
+{
+	for ( int i = 0; i < PLANES_COUNT; i++ )
+	{
+		const float distance = _normals_x[i] * center.x
+			+ _normals_y[i] * center.y
+			+ _normals_z[i] * center.z
+			+ _distances[i];
+		if ( distance < -radius ) return false;
+	}
+
+	return true;
+}
+
+int Frustum::intersect_spheres(
+	const float* centers_x,
+	const float* centers_y,
+	const float* centers_z,
+	const float* radiuses,
+	const int count,
+	uint8* out_results
+) const
+{
+	int visible_count = 0;
+	int index = 0;
+
+#ifdef SPACESHIP_FRUSTUM_SSE
+	// Test 4 spheres at once against each plane
+	for ( ; index + 4 <= count; index += 4 )
+	{
+		const __m128 x = _mm_loadu_ps( centers_x + index );
+		const __m128 y = _mm_loadu_ps( centers_y + index );
+		const __m128 z = _mm_loadu_ps( centers_z + index );
+		const __m128 negative_radius = _mm_sub_ps( _mm_setzero_ps(), _mm_loadu_ps( radiuses + index ) );
+
+		__m128 is_inside = _mm_castsi128_ps( _mm_set1_epi32( -1 ) );
+		for ( int i = 0; i < PLANES_COUNT; i++ )
+		{
+			const __m128 distance = _mm_add_ps(
+				_mm_add_ps(
+					_mm_mul_ps( x, _mm_set1_ps( _normals_x[i] ) ),
+					_mm_mul_ps( y, _mm_set1_ps( _normals_y[i] ) )
+				),
+				_mm_add_ps(
+					_mm_mul_ps( z, _mm_set1_ps( _normals_z[i] ) ),
+					_mm_set1_ps( _distances[i] )
+				)
+			);
+			is_inside = _mm_and_ps( is_inside, _mm_cmpge_ps( distance, negative_radius ) );
+		}
+
+		const int mask = _mm_movemask_ps( is_inside );
+		for ( int lane = 0; lane < 4; lane++ )
+		{
+			const uint8 is_visible = static_cast<uint8>( ( mask >> lane ) & 1 );
+			out_results[index + lane] = is_visible;
+			visible_count += is_visible;
+		}
+	}
+#endif
+
+	// Remaining spheres
+	for ( ; index < count; index++ )
+	{
+		const bool is_visible = intersects_sphere(
+			Vec3 { centers_x[index], centers_y[index], centers_z[index] },
+			radiuses[index]
+		);
+		out_results[index] = is_visible ? 1 : 0;
+		visible_count += is_visible ? 1 : 0;
+	}
+
+	return visible_count;
+}
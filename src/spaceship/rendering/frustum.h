@@ -0,0 +1,51 @@
+#pragma once
+
+#include <suprengine/math/mtx4.h>
+#include <suprengine/math/vec3.h>
+
+namespace spaceship
+{
+	using namespace suprengine;
+
+	/*
+	 * Six planes of a camera view volume, pointing inwards, used to cull bounding
+	 * spheres on the CPU before submitting draws.
+	 *
+	 * Planes are stored per component so spheres are tested in batches with SSE
+	 * instructions when available.
+	 */
+	class Frustum
+	{
+	public:
+		/*
+		 * Extracts the planes from a view-projection matrix, using the engine's
+		 * row-vector convention and OpenGL's clip space.
+		 */
+		static Frustum from_view_projection( const Mtx4& view_projection );
+
+		bool intersects_sphere( const Vec3& center, float radius ) const;
+
+		/*
+		 * Tests spheres given as separate arrays of components. Writes 1 in the
+		 * output array for spheres intersecting the frustum and 0 otherwise.
+		 * Returns the number of intersecting spheres.
+		 */
+		int intersect_spheres(
+			const float* centers_x,
+			const float* centers_y,
+			const float* centers_z,
+			const float* radiuses,
+			int count,
+			uint8* out_results
+		) const;
+
+	public:
+		static constexpr int PLANES_COUNT = 6;
+
+	private:
+		float _normals_x[PLANES_COUNT] {};
+		float _normals_y[PLANES_COUNT] {};
+		float _normals_z[PLANES_COUNT] {};
+		float _distances[PLANES_COUNT] {};
+	};
+}
@@ -0,0 +1,176 @@
+#include "instanced-draw-list.h"
+
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+
+#include <spaceship/rendering/frustum.h>
+#include <spaceship/rendering/occlusion-buffer.h>
+
+using namespace spaceship;
+
+bool DrawBatchKey::operator<( const DrawBatchKey& other ) const
+{
+	return std::tie( is_front_face_ccw, model )
+		< std::tie( other.is_front_face_ccw, other.model );
+}
+
+bool DrawBatchKey::operator==( const DrawBatchKey& other ) const
+{
+	return model == other.model
+		&& is_front_face_ccw == other.is_front_face_ccw;
+}
+
+void InstancedDrawList::add(
+	const SharedPtr<Model>& model,
+	const bool is_front_face_ccw,
+	const Mtx4& matrix,
+	const Color modulate,
+	const float outline_scale
+)
+{
+	if ( !model ) return;
+
+	const DrawBatchKey key {
+		.model = model.get(),
+		.is_front_face_ccw = is_front_face_ccw,
+	};
+
+	// Find the batch or insert it at its sorted place
+	auto itr = std::lower_bound( _batches.begin(), _batches.end(), key,
+		[]( const DrawBatch& batch, const DrawBatchKey& key )
+		{
+			return batch.key < key;
+		}
+	);
+	if ( itr == _batches.end() || !( itr->key == key ) )
+	{
+		const Box& bounds = model->get_bounds();
+
+		DrawBatch batch { key, model, {} };
+		batch.bounds_center = ( bounds.min + bounds.max ) * 0.5f;
+		batch.bounds_radius = ( bounds.max - bounds.min ).length() * 0.5f;
+		itr = _batches.insert( itr, std::move( batch ) );
+	}
+
+	itr->instances.push_back( DrawInstance { matrix, modulate, outline_scale } );
+	_instances_count++;
+}
+
+void InstancedDrawList::add_occluder( const Vec3& center, const float radius )
+{
+	_occluders.push_back( OccluderSphere { center, radius } );
+}
+
+void InstancedDrawList::clear()
+{
+	_occluders.clear();
+
+	for ( DrawBatch& batch : _batches )
+	{
+		batch.instances.clear();
+	}
+	_instances_count = 0;
+	_culled_count = 0;
+	_occluded_count = 0;
+}
+
+int InstancedDrawList::cull( const Frustum& frustum, const OcclusionBuffer* occlusion_buffer )
+{
+	int culled_count = 0;
+	int occluded_count = 0;
+
+	for ( DrawBatch& batch : _batches )
+	{
+		const int count = static_cast<int>( batch.instances.size() );
+		if ( count == 0 ) continue;
+
+		_spheres_x.resize( count );
+		_spheres_y.resize( count );
+		_spheres_z.resize( count );
+		_spheres_radius.resize( count );
+		_visibilities.resize( count );
+
+		// Transform the model bounding sphere by each instance matrix
+		const Vec3& center = batch.bounds_center;
+		for ( int i = 0; i < count; i++ )
+		{
+			const DrawInstance& instance = batch.instances[i];
+			const auto& mat = instance.matrix.mat;
+
+			_spheres_x[i] = center.x * mat[0][0] + center.y * mat[1][0] + center.z * mat[2][0] + mat[3][0];
+			_spheres_y[i] = center.x * mat[0][1] + center.y * mat[1][1] + center.z * mat[2][1] + mat[3][1];
+			_spheres_z[i] = center.x * mat[0][2] + center.y * mat[1][2] + center.z * mat[2][2] + mat[3][2];
+
+			// Largest axis scale, from the lengths of the matrix rows
+			float max_scale_sqr = 0.0f;
+			for ( int row = 0; row < 3; row++ )
+			{
+				const float scale_sqr = mat[row][0] * mat[row][0]
+					+ mat[row][1] * mat[row][1]
+					+ mat[row][2] * mat[row][2];
+				max_scale_sqr = std::max( max_scale_sqr, scale_sqr );
+			}
+
+			_spheres_radius[i] = batch.bounds_radius
+				* std::sqrt( max_scale_sqr )
+				* ( 1.0f + instance.outline_scale );
+		}
+
+		int visible_count = frustum.intersect_spheres(
+			_spheres_x.data(),
+			_spheres_y.data(),
+			_spheres_z.data(),
+			_spheres_radius.data(),
+			count,
+			_visibilities.data()
+		);
+
+		// Test remaining instances against occluders
+		if ( occlusion_buffer != nullptr )
+		{
+			for ( int i = 0; i < count; i++ )
+			{
+				if ( !_visibilities[i] ) continue;
+
+				const Vec3 sphere_center { _spheres_x[i], _spheres_y[i], _spheres_z[i] };
+				if ( occlusion_buffer->is_sphere_occluded( sphere_center, _spheres_radius[i] ) )
+				{
+					_visibilities[i] = 0;
+					visible_count--;
+					occluded_count++;
+				}
+			}
+		}
+		if ( visible_count == count ) continue;
+
+		// Compact visible instances, keeping their order
+		int visible_index = 0;
+		for ( int i = 0; i < count; i++ )
+		{
+			if ( !_visibilities[i] ) continue;
+
+			batch.instances[visible_index++] = batch.instances[i];
+		}
+		batch.instances.resize( visible_count );
+
+		culled_count += count - visible_count;
+	}
+
+	_instances_count -= culled_count;
+	_culled_count += culled_count;
+	_occluded_count += occluded_count;
+	return culled_count;
+}
+
+int InstancedDrawList::get_draw_calls_count() const
+{
+	int count = 0;
+	for ( const DrawBatch& batch : _batches )
+	{
+		if ( batch.instances.empty() ) continue;
+
+		count += batch.model->get_mesh_count();
+	}
+	return count;
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <vector>
+
+#include <suprengine/math/color.h>
+#include <suprengine/math/mtx4.h>
+#include <suprengine/rendering/model.h>
+#include <suprengine/utils/memory.h>
+
+namespace spaceship
+{
+	using namespace suprengine;
+
+	struct DrawBatchKey
+	{
+		const Model* model = nullptr;
+		bool is_front_face_ccw = false;
+
+		bool operator<( const DrawBatchKey& other ) const;
+		bool operator==( const DrawBatchKey& other ) const;
+	};
+
+	/*
+	 * Per-instance data, uploaded as-is to the instance buffer.
+	 */
+	struct DrawInstance
+	{
+		Mtx4 matrix;
+		Color modulate;
+		//  Scale applied about the model origin, before the matrix
+		float outline_scale;
+	};
+
+	struct DrawBatch
+	{
+		DrawBatchKey key;
+		SharedPtr<Model> model;
+		std::vector<DrawInstance> instances;
+
+		//  Local bounding sphere of the model, computed from its bounds
+		Vec3 bounds_center = Vec3::zero;
+		float bounds_radius = 0.0f;
+	};
+
+	struct OccluderSphere
+	{
+		Vec3 center;
+		float radius;
+	};
+
+	class Frustum;
+	class OcclusionBuffer;
+
+	/*
+	 * Collects model draws grouped by model and front face, so each group can be
+	 * submitted as a single instanced draw per mesh. It doesn't depend on OpenGL,
+	 * submission is left to the InstancedRenderer.
+	 *
+	 * Outline and inner passes of an object share its matrix and only differ by
+	 * their outline scale, so both end up in the same batch when their front
+	 * faces match.
+	 *
+	 * Batches are kept sorted by front face and model, and are never removed on
+	 * clear so their instances storage is re-used between frames.
+	 */
+	class InstancedDrawList
+	{
+	public:
+		void add(
+			const SharedPtr<Model>& model,
+			bool is_front_face_ccw,
+			const Mtx4& matrix,
+			Color modulate,
+			float outline_scale = 0.0f
+		);
+		/*
+		 * Adds a sphere hiding what is behind it, which must be fully inside the
+		 * geometry it stands for.
+		 */
+		void add_occluder( const Vec3& center, float radius );
+		void clear();
+
+		/*
+		 * Removes instances whose world bounding sphere is outside of the frustum,
+		 * tested in batches over all instances of each batch, then instances
+		 * hidden in the occlusion buffer, if given. Returns the number of culled
+		 * instances.
+		 */
+		int cull( const Frustum& frustum, const OcclusionBuffer* occlusion_buffer = nullptr );
+
+		const std::vector<DrawBatch>& get_batches() const { return _batches; }
+		const std::vector<OccluderSphere>& get_occluders() const { return _occluders; }
+
+		/*
+		 * Returns the number of instanced draw calls needed to submit the list,
+		 * which is one per mesh of each non-empty batch.
+		 */
+		int get_draw_calls_count() const;
+		int get_instances_count() const { return _instances_count; }
+		//  Number of instances culled since the last clear, occluded ones included
+		int get_culled_count() const { return _culled_count; }
+		//  Number of instances hidden by occluders since the last clear
+		int get_occluded_count() const { return _occluded_count; }
+
+	private:
+		std::vector<DrawBatch> _batches;
+		int _instances_count = 0;
+		int _culled_count = 0;
+		int _occluded_count = 0;
+
+		std::vector<OccluderSphere> _occluders;
+
+		//  World bounding spheres of a batch, re-used between batches
+		std::vector<float> _spheres_x, _spheres_y, _spheres_z, _spheres_radius;
+		std::vector<uint8> _visibilities;
+	};
+}
@@ -0,0 +1,143 @@
+#include "lean-model.h"
+
+#include <cmath>
+
+#include <spaceship/rendering/mesh-buffers.h>
+
+#include <suprengine/rendering/mesh.h>
+
+#include <gl/glew.h>
+
+using namespace spaceship;
+
+LeanModel::~LeanModel()
+{
+	_release();
+}
+
+bool LeanModel::build( const Model& model, const bool should_quantize )
+{
+	_release();
+	_is_quantized = should_quantize;
+
+	MeshBuffers buffers {};
+	const int meshes_count = model.get_mesh_count();
+	_meshes.reserve( meshes_count );
+	for ( int i = 0; i < meshes_count; i++ )
+	{
+		if ( !MeshBuffers::read_from( model.get_mesh( i )->get_vertex_array(), &buffers ) )
+		{
+			_release();
+			return false;
+		}
+
+		const uint32 vertices_count = buffers.get_vertices_count();
+		const float* vertices = buffers.vertices.data();
+
+		LeanMesh mesh {};
+		mesh.indices_count = static_cast<uint32>( buffers.indices.size() );
+
+		glGenVertexArrays( 1, &mesh.vertex_array_id );
+		glBindVertexArray( mesh.vertex_array_id );
+
+		glGenBuffers( 1, &mesh.vertex_buffer_id );
+		glBindBuffer( GL_ARRAY_BUFFER, mesh.vertex_buffer_id );
+		glEnableVertexAttribArray( POSITION_ATTRIBUTE_LOCATION );
+
+		if ( should_quantize )
+		{
+			// Bounds of this mesh
+			Vec3 min = Vec3::zero, max = Vec3::zero;
+			for ( uint32 v = 0; v < vertices_count; v++ )
+			{
+				const float* position = &vertices[v * MeshBuffers::FLOATS_PER_VERTEX];
+				const Vec3 point( position[0], position[1], position[2] );
+				min = v == 0 ? point : Vec3::min( min, point );
+				max = v == 0 ? point : Vec3::max( max, point );
+			}
+
+			// Avoid dividing by zero on flat meshes
+			mesh.position_offset = ( min + max ) * 0.5f;
+			mesh.position_scale = Vec3 {
+				math::max( ( max.x - min.x ) * 0.5f, 1e-6f ),
+				math::max( ( max.y - min.y ) * 0.5f, 1e-6f ),
+				math::max( ( max.z - min.z ) * 0.5f, 1e-6f ),
+			};
+
+			// Fourth component pads vertices to 8 bytes
+			std::vector<int16_t> positions( static_cast<size_t>( vertices_count ) * 4, 0 );
+			for ( uint32 v = 0; v < vertices_count; v++ )
+			{
+				const float* position = &vertices[v * MeshBuffers::FLOATS_PER_VERTEX];
+				const float normalized[3] {
+					( position[0] - mesh.position_offset.x ) / mesh.position_scale.x,
+					( position[1] - mesh.position_offset.y ) / mesh.position_scale.y,
+					( position[2] - mesh.position_offset.z ) / mesh.position_scale.z,
+				};
+				for ( int axis = 0; axis < 3; axis++ )
+				{
+					const float value = math::clamp( normalized[axis], -1.0f, 1.0f );
+					positions[v * 4 + axis] = static_cast<int16_t>( std::round( value * 32767.0f ) );
+				}
+			}
+
+			glBufferData(
+				GL_ARRAY_BUFFER,
+				static_cast<GLsizeiptr>( positions.size() * sizeof( int16_t ) ),
+				positions.data(),
+				GL_STATIC_DRAW
+			);
+			glVertexAttribPointer(
+				POSITION_ATTRIBUTE_LOCATION, 3, GL_SHORT, GL_TRUE,
+				4 * sizeof( int16_t ), nullptr
+			);
+		}
+		else
+		{
+			std::vector<float> positions( static_cast<size_t>( vertices_count ) * 3 );
+			for ( uint32 v = 0; v < vertices_count; v++ )
+			{
+				const float* position = &vertices[v * MeshBuffers::FLOATS_PER_VERTEX];
+				positions[v * 3 + 0] = position[0];
+				positions[v * 3 + 1] = position[1];
+				positions[v * 3 + 2] = position[2];
+			}
+
+			glBufferData(
+				GL_ARRAY_BUFFER,
+				static_cast<GLsizeiptr>( positions.size() * sizeof( float ) ),
+				positions.data(),
+				GL_STATIC_DRAW
+			);
+			glVertexAttribPointer(
+				POSITION_ATTRIBUTE_LOCATION, 3, GL_FLOAT, GL_FALSE,
+				3 * sizeof( float ), nullptr
+			);
+		}
+
+		glGenBuffers( 1, &mesh.index_buffer_id );
+		glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, mesh.index_buffer_id );
+		glBufferData(
+			GL_ELEMENT_ARRAY_BUFFER,
+			static_cast<GLsizeiptr>( buffers.indices.size() * sizeof( uint32 ) ),
+			buffers.indices.data(),
+			GL_STATIC_DRAW
+		);
+
+		_meshes.push_back( mesh );
+	}
+
+	glBindVertexArray( 0 );
+	return true;
+}
+
+void LeanModel::_release()
+{
+	for ( LeanMesh& mesh : _meshes )
+	{
+		glDeleteVertexArrays( 1, &mesh.vertex_array_id );
+		glDeleteBuffers( 1, &mesh.vertex_buffer_id );
+		glDeleteBuffers( 1, &mesh.index_buffer_id );
+	}
+	_meshes.clear();
+}
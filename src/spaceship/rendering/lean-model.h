@@ -0,0 +1,60 @@
+#pragma once
+
+#include <vector>
+
+#include <suprengine/rendering/model.h>
+
+namespace spaceship
+{
+	using namespace suprengine;
+
+	/*
+	 * GPU copy of a model keeping only vertex positions, for shaders which
+	 * don't read normals nor uvs. Positions are optionally quantized to 16-bits
+	 * integers relative to the bounds of each mesh, dropping the vertex stride
+	 * from 32 bytes to 8 bytes. Indices are copied as is.
+	 *
+	 * The source model keeps its full vertex format for other shaders.
+	 */
+	class LeanModel
+	{
+	public:
+		struct LeanMesh
+		{
+			uint32 vertex_array_id = 0;
+			uint32 vertex_buffer_id = 0;
+			uint32 index_buffer_id = 0;
+			uint32 indices_count = 0;
+
+			//  Dequantized position is 'position * scale + offset'
+			Vec3 position_offset = Vec3::zero;
+			Vec3 position_scale = Vec3::one;
+		};
+
+	public:
+		LeanModel() = default;
+		~LeanModel();
+		LeanModel( const LeanModel& ) = delete;
+		LeanModel& operator=( const LeanModel& ) = delete;
+
+		/*
+		 * Reads back the buffers of the model and uploads its positions into
+		 * new vertex arrays. Main thread only.
+		 */
+		bool build( const Model& model, bool should_quantize );
+
+		const std::vector<LeanMesh>& get_meshes() const { return _meshes; }
+		bool is_quantized() const { return _is_quantized; }
+
+	public:
+		//  Vertex attribute location of the position, matching the engine's layout
+		static constexpr uint32 POSITION_ATTRIBUTE_LOCATION = 0;
+
+	private:
+		void _release();
+
+	private:
+		std::vector<LeanMesh> _meshes {};
+		bool _is_quantized = false;
+	};
+}
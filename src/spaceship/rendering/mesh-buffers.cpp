@@ -0,0 +1,35 @@
+#include "mesh-buffers.h"
+
+#include <gl/glew.h>
+
+using namespace spaceship;
+
+bool MeshBuffers::read_from( VertexArray* vertex_array, MeshBuffers* out_buffers )
+{
+	vertex_array->activate();
+
+	GLint vertex_buffer_id = 0, stride = 0, index_buffer_id = 0;
+	glGetVertexAttribiv( 0, GL_VERTEX_ATTRIB_ARRAY_BUFFER_BINDING, &vertex_buffer_id );
+	glGetVertexAttribiv( 0, GL_VERTEX_ATTRIB_ARRAY_STRIDE, &stride );
+	glGetIntegerv( GL_ELEMENT_ARRAY_BUFFER_BINDING, &index_buffer_id );
+	if ( vertex_buffer_id == 0 || index_buffer_id == 0 ) return false;
+	if ( stride != static_cast<GLint>( FLOATS_PER_VERTEX * sizeof( float ) ) ) return false;
+
+	out_buffers->vertices.resize( static_cast<size_t>( vertex_array->get_vertices_count() ) * FLOATS_PER_VERTEX );
+	glBindBuffer( GL_ARRAY_BUFFER, static_cast<GLuint>( vertex_buffer_id ) );
+	glGetBufferSubData(
+		GL_ARRAY_BUFFER, 0,
+		static_cast<GLsizeiptr>( out_buffers->vertices.size() * sizeof( float ) ),
+		out_buffers->vertices.data()
+	);
+
+	// Element buffer is already bound by the vertex array
+	out_buffers->indices.resize( vertex_array->get_indices_count() );
+	glGetBufferSubData(
+		GL_ELEMENT_ARRAY_BUFFER, 0,
+		static_cast<GLsizeiptr>( out_buffers->indices.size() * sizeof( uint32 ) ),
+		out_buffers->indices.data()
+	);
+
+	return true;
+}
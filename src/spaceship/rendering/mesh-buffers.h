@@ -0,0 +1,30 @@
+#pragma once
+
+#include <vector>
+
+#include <suprengine/rendering/vertex-array.h>
+
+namespace spaceship
+{
+	using namespace suprengine;
+
+	/*
+	 * CPU copy of the buffers of a vertex array, in the engine's vertex layout:
+	 * position, normal and uv.
+	 */
+	struct MeshBuffers
+	{
+		std::vector<float> vertices;
+		std::vector<uint32> indices;
+
+		uint32 get_vertices_count() const { return static_cast<uint32>( vertices.size() / FLOATS_PER_VERTEX ); }
+
+		/*
+		 * Reads back the buffers uploaded to OpenGL by a vertex array. Fails when
+		 * its layout isn't the expected one. Main thread only.
+		 */
+		static bool read_from( VertexArray* vertex_array, MeshBuffers* out_buffers );
+
+		static constexpr uint32 FLOATS_PER_VERTEX = 8;
+	};
+}
@@ -0,0 +1,284 @@
+#include "mesh-cache.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include <suprengine/core/assets.h>
+#include <suprengine/rendering/mesh.h>
+#include <suprengine/rendering/vertex-array.h>
+#include <suprengine/utils/logger.h>
+
+using namespace spaceship;
+
+namespace
+{
+	struct CookedHeader
+	{
+		uint32 magic;
+		uint32 version;
+		uint64 source_size;
+		int64_t source_write_time;
+		uint64 source_hash;
+		uint32 meshes_count;
+		uint32 padding;
+	};
+
+	//  Followed by the vertices then the indices
+	struct CookedMeshHeader
+	{
+		uint32 vertices_count;
+		uint32 indices_count;
+	};
+}
+
+MeshCache::MeshCache( std::string folder_path )
+	: _folder_path( std::move( folder_path ) )
+{
+	std::error_code error {};
+	std::filesystem::create_directories( _folder_path, error );
+}
+
+SharedPtr<Model> MeshCache::load_model( const std::string& name, const std::string& source_path )
+{
+	CookedModel cooked_model = read( name, source_path );
+	return finish( cooked_model );
+}
+
+MeshCache::CookedModel MeshCache::read( const std::string& name, const std::string& source_path ) const
+{
+	CookedModel cooked_model {};
+	cooked_model.name = name;
+	cooked_model.source_path = source_path;
+	cooked_model.cooked_path = _get_cooked_path( name );
+
+	// Get source file infos
+	std::error_code error {};
+	SourceInfo& source = cooked_model.source;
+	source.size = static_cast<uint64>( std::filesystem::file_size( source_path, error ) );
+	if ( !error )
+	{
+		source.write_time = static_cast<int64_t>(
+			std::filesystem::last_write_time( source_path, error ).time_since_epoch().count()
+		);
+	}
+	cooked_model.is_source_readable = !error;
+	if ( !cooked_model.is_source_readable ) return cooked_model;
+
+	cooked_model.is_valid = _read_cooked( cooked_model );
+	if ( !cooked_model.is_valid )
+	{
+		cooked_model.file.reset();
+		cooked_model.meshes.clear();
+
+		// Hash now, so cooking on the main thread doesn't have to
+		if ( !source.is_hash_computed )
+		{
+			source.hash = _hash_file( source_path );
+			source.is_hash_computed = true;
+		}
+	}
+
+	return cooked_model;
+}
+
+SharedPtr<Model> MeshCache::finish( CookedModel& cooked_model )
+{
+	const std::string& name = cooked_model.name;
+	const std::string& source_path = cooked_model.source_path;
+
+	if ( !cooked_model.is_source_readable )
+	{
+		Logger::error( "Failed to read model source '%s', it can't be cooked.", source_path.c_str() );
+		return Assets::load_model( name, source_path );
+	}
+
+	// Upload the cooked buffers straight from the mapping
+	if ( cooked_model.is_valid )
+	{
+		std::vector<SharedPtr<Mesh>> meshes;
+		meshes.reserve( cooked_model.meshes.size() );
+		for ( const CookedMeshView& view : cooked_model.meshes )
+		{
+			VertexArray* vertex_array = new VertexArray(
+				view.vertices, view.vertices_count,
+				view.indices, view.indices_count
+			);
+			meshes.push_back( std::make_shared<Mesh>( vertex_array ) );
+		}
+		cooked_model.file.reset();
+		cooked_model.meshes.clear();
+
+		// The cooked file has been read with an older modification time, update it
+		if ( cooked_model.should_update_write_time )
+		{
+			CookedHeader header {};
+			std::fstream stream( cooked_model.cooked_path, std::ios::binary | std::ios::in | std::ios::out );
+			stream.read( reinterpret_cast<char*>( &header ), sizeof( CookedHeader ) );
+			header.source_write_time = cooked_model.source.write_time;
+			stream.seekp( 0 );
+			stream.write( reinterpret_cast<const char*>( &header ), sizeof( CookedHeader ) );
+		}
+
+		const SharedPtr<Model> model = std::make_shared<Model>( meshes, source_path );
+		Assets::add_model( name, model );
+		_hits_count++;
+		return model;
+	}
+
+	// Import source and cook it for the next time
+	_misses_count++;
+
+	const SharedPtr<Model> model = Assets::load_model( name, source_path );
+	if ( !model ) return nullptr;
+
+	if ( !_cook( model, cooked_model.cooked_path, cooked_model.source ) )
+	{
+		Logger::warning( "Failed to cook model '%s'.", name.c_str() );
+	}
+
+	return model;
+}
+
+bool MeshCache::_read_cooked( CookedModel& cooked_model ) const
+{
+	cooked_model.file = std::make_unique<MappedFile>();
+
+	MappedFile& file = *cooked_model.file;
+	if ( !file.open( cooked_model.cooked_path ) ) return false;
+	if ( file.get_size() < sizeof( CookedHeader ) ) return false;
+
+	const unsigned char* data = file.get_data();
+	const unsigned char* end = data + file.get_size();
+
+	CookedHeader header {};
+	std::memcpy( &header, data, sizeof( CookedHeader ) );
+	data += sizeof( CookedHeader );
+
+	SourceInfo& source = cooked_model.source;
+	if ( header.magic != MAGIC || header.version != VERSION ) return false;
+	if ( header.source_size != source.size ) return false;
+
+	// A different modification time doesn't mean a different content
+	if ( header.source_write_time != source.write_time )
+	{
+		source.hash = _hash_file( cooked_model.source_path );
+		source.is_hash_computed = true;
+		if ( header.source_hash != source.hash ) return false;
+
+		cooked_model.should_update_write_time = true;
+	}
+
+	cooked_model.meshes.reserve( header.meshes_count );
+	for ( uint32 i = 0; i < header.meshes_count; i++ )
+	{
+		if ( end - data < static_cast<std::ptrdiff_t>( sizeof( CookedMeshHeader ) ) ) return false;
+
+		CookedMeshHeader mesh_header {};
+		std::memcpy( &mesh_header, data, sizeof( CookedMeshHeader ) );
+		data += sizeof( CookedMeshHeader );
+
+		const size_t vertices_size = static_cast<size_t>( mesh_header.vertices_count ) * VERTEX_FLOATS_COUNT * sizeof( float );
+		const size_t indices_size = static_cast<size_t>( mesh_header.indices_count ) * sizeof( uint32 );
+		if ( static_cast<size_t>( end - data ) < vertices_size + indices_size ) return false;
+
+		// Buffers are 4-bytes aligned, they are uploaded straight from the mapping
+		cooked_model.meshes.push_back(
+			CookedMeshView {
+				.vertices = reinterpret_cast<const float*>( data ),
+				.vertices_count = mesh_header.vertices_count,
+				.indices = reinterpret_cast<const uint32*>( data + vertices_size ),
+				.indices_count = mesh_header.indices_count,
+			}
+		);
+		data += vertices_size + indices_size;
+	}
+
+	return true;
+}
+
+bool MeshCache::_cook(
+	const SharedPtr<Model>& model,
+	const std::string& cooked_path,
+	const SourceInfo& source
+) const
+{
+	// Write to a temporary file, so an interrupted cook never leaves a valid header
+	const std::string temporary_path = cooked_path + ".tmp";
+	std::ofstream stream( temporary_path, std::ios::binary | std::ios::trunc );
+	if ( !stream.is_open() ) return false;
+
+	const CookedHeader header {
+		.magic = MAGIC,
+		.version = VERSION,
+		.source_size = source.size,
+		.source_write_time = source.write_time,
+		.source_hash = source.hash,
+		.meshes_count = static_cast<uint32>( model->get_mesh_count() ),
+		.padding = 0,
+	};
+	stream.write( reinterpret_cast<const char*>( &header ), sizeof( CookedHeader ) );
+
+	// Read back the buffers uploaded by the importer
+	bool is_cooked = true;
+	MeshBuffers buffers {};
+	for ( int i = 0; i < model->get_mesh_count(); i++ )
+	{
+		if ( !MeshBuffers::read_from( model->get_mesh( i )->get_vertex_array(), &buffers ) )
+		{
+			is_cooked = false;
+			break;
+		}
+
+		const CookedMeshHeader mesh_header {
+			.vertices_count = buffers.get_vertices_count(),
+			.indices_count = static_cast<uint32>( buffers.indices.size() ),
+		};
+		stream.write( reinterpret_cast<const char*>( &mesh_header ), sizeof( CookedMeshHeader ) );
+		stream.write(
+			reinterpret_cast<const char*>( buffers.vertices.data() ),
+			static_cast<std::streamsize>( buffers.vertices.size() * sizeof( float ) )
+		);
+		stream.write(
+			reinterpret_cast<const char*>( buffers.indices.data() ),
+			static_cast<std::streamsize>( buffers.indices.size() * sizeof( uint32 ) )
+		);
+	}
+
+	stream.close();
+
+	std::error_code error {};
+	if ( !is_cooked || !stream )
+	{
+		std::filesystem::remove( temporary_path, error );
+		return false;
+	}
+
+	std::filesystem::rename( temporary_path, cooked_path, error );
+	return !error;
+}
+
+std::string MeshCache::_get_cooked_path( const std::string& name ) const
+{
+	return _folder_path + name + ".mesh";
+}
+
+uint64 MeshCache::_hash_file( const std::string& path )
+{
+	// FNV-1a 64-bits
+	uint64 hash = 0xcbf29ce484222325;
+
+	std::ifstream stream( path, std::ios::binary );
+	char chunk[4096];
+	while ( stream.read( chunk, sizeof( chunk ) ) || stream.gcount() > 0 )
+	{
+		const std::streamsize count = stream.gcount();
+		for ( std::streamsize i = 0; i < count; i++ )
+		{
+			hash = ( hash ^ static_cast<unsigned char>( chunk[i] ) ) * 0x100000001b3;
+		}
+	}
+
+	return hash;
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <spaceship/rendering/mesh-buffers.h>
+#include <spaceship/utils/mapped-file.h>
+
+#include <suprengine/rendering/model.h>
+#include <suprengine/utils/memory.h>
+
+namespace spaceship
+{
+	using namespace suprengine;
+
+	/*
+	 * Loads models from cooked binary files instead of parsing their sources.
+	 *
+	 * On a cache miss, the source is imported through the engine and the vertices
+	 * and indices it uploaded are read back to cook a blob of raw buffers, so a
+	 * cooked model is exactly what the importer produces. Cooked files are keyed
+	 * by the source size, modification time and hash: when only the modification
+	 * time changes, the hash is checked before cooking again.
+	 *
+	 * Cooked files are memory-mapped and their buffers uploaded directly.
+	 *
+	 * Loading is split in two steps: 'read' validates and maps the cooked file
+	 * and can run on any thread, while 'finish' uploads it, or imports the source
+	 * on a miss, and must run on the main thread, with an OpenGL context.
+	 */
+	class MeshCache
+	{
+	public:
+		struct SourceInfo
+		{
+			uint64 size = 0;
+			int64_t write_time = 0;
+			uint64 hash = 0;
+			bool is_hash_computed = false;
+		};
+
+		struct CookedMeshView
+		{
+			const float* vertices = nullptr;
+			uint32 vertices_count = 0;
+			const uint32* indices = nullptr;
+			uint32 indices_count = 0;
+		};
+
+		/*
+		 * Result of reading a cooked model, valid when its cooked file is
+		 * up-to-date. Meshes point into the mapped file.
+		 */
+		struct CookedModel
+		{
+			std::string name;
+			std::string source_path;
+			std::string cooked_path;
+
+			SourceInfo source {};
+			bool is_source_readable = false;
+
+			bool is_valid = false;
+			//  Set when only the modification time of the header is outdated
+			bool should_update_write_time = false;
+
+			std::unique_ptr<MappedFile> file;
+			std::vector<CookedMeshView> meshes;
+		};
+
+	public:
+		explicit MeshCache( std::string folder_path );
+
+		/*
+		 * Loads the model from its cooked file when up-to-date, otherwise from its
+		 * source, and registers it in the assets under the given name.
+		 */
+		SharedPtr<Model> load_model( const std::string& name, const std::string& source_path );
+
+		/*
+		 * Maps and validates the cooked file of a model, thread-safe.
+		 */
+		CookedModel read( const std::string& name, const std::string& source_path ) const;
+		/*
+		 * Uploads a read model, or imports and cooks its source when the cooked
+		 * file was invalid, then registers it in the assets. Main thread only.
+		 */
+		SharedPtr<Model> finish( CookedModel& cooked_model );
+
+		int get_hits_count() const { return _hits_count; }
+		int get_misses_count() const { return _misses_count; }
+
+	public:
+		//  Cooked files version, increase it when changing their layout
+		static constexpr uint32 VERSION = 1;
+		static constexpr uint32 MAGIC = 0x434D5053;  //  'SPMC'
+
+		//  Vertex layout expected by the engine: position, normal and uv
+		static constexpr uint32 VERTEX_FLOATS_COUNT = MeshBuffers::FLOATS_PER_VERTEX;
+
+	private:
+		bool _read_cooked( CookedModel& cooked_model ) const;
+		bool _cook( const SharedPtr<Model>& model, const std::string& cooked_path, const SourceInfo& source ) const;
+
+		std::string _get_cooked_path( const std::string& name ) const;
+		static uint64 _hash_file( const std::string& path );
+
+	private:
+		std::string _folder_path;
+
+		int _hits_count = 0;
+		int _misses_count = 0;
+	};
+}
@@ -0,0 +1,106 @@
+#include "mesh-simplifier.h"
+
+#include <cmath>
+#include <unordered_map>
+
+using namespace spaceship;
+
+bool MeshSimplifier::cluster_vertices(
+	const float* vertices,
+	const uint32 vertices_count,
+	const uint32* indices,
+	const uint32 indices_count,
+	const int grid_resolution,
+	MeshBuffers* out_buffers
+)
+{
+	constexpr uint32 STRIDE = MeshBuffers::FLOATS_PER_VERTEX;
+
+	out_buffers->vertices.clear();
+	out_buffers->indices.clear();
+	if ( vertices_count == 0 || indices_count < 3 || grid_resolution < 1 ) return false;
+
+	// Bounds
+	Vec3 min { vertices[0], vertices[1], vertices[2] };
+	Vec3 max = min;
+	for ( uint32 v = 1; v < vertices_count; v++ )
+	{
+		const float* vertex = &vertices[v * STRIDE];
+		const Vec3 position { vertex[0], vertex[1], vertex[2] };
+		min = Vec3::min( min, position );
+		max = Vec3::max( max, position );
+	}
+
+	const Vec3 extents = max - min;
+	const float largest_extent = math::max( extents.x, math::max( extents.y, extents.z ) );
+	if ( largest_extent <= 0.0f ) return false;
+	const float inverse_cell_size = static_cast<float>( grid_resolution ) / largest_extent;
+
+	// Assign each vertex to its cell, in vertices order so the output is deterministic
+	std::unordered_map<uint64, uint32> cells;
+	std::vector<uint32> remap( vertices_count );
+	std::vector<uint32> merged_counts;
+	for ( uint32 v = 0; v < vertices_count; v++ )
+	{
+		const float* vertex = &vertices[v * STRIDE];
+		const uint64 cell_x = static_cast<uint64>( ( vertex[0] - min.x ) * inverse_cell_size );
+		const uint64 cell_y = static_cast<uint64>( ( vertex[1] - min.y ) * inverse_cell_size );
+		const uint64 cell_z = static_cast<uint64>( ( vertex[2] - min.z ) * inverse_cell_size );
+		const uint64 cell_key = cell_x | ( cell_y << 21 ) | ( cell_z << 42 );
+
+		const auto [itr, is_inserted] = cells.try_emplace( cell_key, static_cast<uint32>( merged_counts.size() ) );
+		const uint32 merged_index = itr->second;
+		remap[v] = merged_index;
+
+		// Sum positions and normals, keep the uv of the first vertex
+		if ( is_inserted )
+		{
+			out_buffers->vertices.insert( out_buffers->vertices.end(), vertex, vertex + STRIDE );
+			merged_counts.push_back( 1 );
+			continue;
+		}
+
+		float* merged = &out_buffers->vertices[merged_index * STRIDE];
+		for ( int i = 0; i < 6; i++ )
+		{
+			merged[i] += vertex[i];
+		}
+		merged_counts[merged_index]++;
+	}
+
+	// Average positions and normalize normals
+	for ( uint32 m = 0; m < static_cast<uint32>( merged_counts.size() ); m++ )
+	{
+		float* merged = &out_buffers->vertices[m * STRIDE];
+		const float count = static_cast<float>( merged_counts[m] );
+		merged[0] /= count;
+		merged[1] /= count;
+		merged[2] /= count;
+
+		const float normal_length = std::sqrt( merged[3] * merged[3] + merged[4] * merged[4] + merged[5] * merged[5] );
+		if ( normal_length > 0.0f )
+		{
+			merged[3] /= normal_length;
+			merged[4] /= normal_length;
+			merged[5] /= normal_length;
+		}
+	}
+
+	// Keep triangles whose corners are still in distinct cells
+	out_buffers->indices.reserve( indices_count );
+	for ( uint32 i = 0; i + 2 < indices_count; i += 3 )
+	{
+		if ( indices[i] >= vertices_count || indices[i + 1] >= vertices_count || indices[i + 2] >= vertices_count ) return false;
+
+		const uint32 a = remap[indices[i]];
+		const uint32 b = remap[indices[i + 1]];
+		const uint32 c = remap[indices[i + 2]];
+		if ( a == b || b == c || a == c ) continue;
+
+		out_buffers->indices.push_back( a );
+		out_buffers->indices.push_back( b );
+		out_buffers->indices.push_back( c );
+	}
+
+	return !out_buffers->indices.empty();
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <spaceship/rendering/mesh-buffers.h>
+
+namespace spaceship
+{
+	using namespace suprengine;
+
+	/*
+	 * Simplifies meshes by vertex clustering: vertices are snapped to a uniform
+	 * grid over the mesh bounds, vertices sharing a cell are merged into their
+	 * average and triangles collapsing to a line or a point are removed.
+	 *
+	 * It doesn't depend on OpenGL and can run on any thread.
+	 */
+	class MeshSimplifier
+	{
+	public:
+		/*
+		 * Simplifies the mesh with the given number of cells along the largest axis
+		 * of its bounds. Vertices are in the engine's layout. Returns false when no
+		 * triangle remains.
+		 */
+		static bool cluster_vertices(
+			const float* vertices,
+			uint32 vertices_count,
+			const uint32* indices,
+			uint32 indices_count,
+			int grid_resolution,
+			MeshBuffers* out_buffers
+		);
+	};
+}
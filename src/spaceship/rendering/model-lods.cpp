@@ -0,0 +1,157 @@
+#include "model-lods.h"
+
+#include <cmath>
+
+#include <spaceship/rendering/mesh-simplifier.h>
+
+#include <suprengine/rendering/mesh.h>
+#include <suprengine/rendering/vertex-array.h>
+
+using namespace spaceship;
+
+std::unordered_map<const Model*, std::vector<SharedPtr<Model>>> ModelLods::_levels;
+
+ModelLods::SimplifiedLevels ModelLods::simplify( const std::vector<MeshCache::CookedMeshView>& meshes )
+{
+	SimplifiedLevels levels {};
+	if ( meshes.empty() ) return levels;
+
+	uint32 previous_indices_count = 0;
+	for ( const MeshCache::CookedMeshView& mesh : meshes )
+	{
+		previous_indices_count += mesh.indices_count;
+	}
+
+	for ( const int grid_resolution : LEVEL_GRID_RESOLUTIONS )
+	{
+		std::vector<MeshBuffers> level( meshes.size() );
+
+		// Each level is simplified from the source meshes, so errors don't accumulate
+		uint32 indices_count = 0;
+		for ( size_t i = 0; i < meshes.size(); i++ )
+		{
+			const MeshCache::CookedMeshView& mesh = meshes[i];
+			if ( !MeshSimplifier::cluster_vertices(
+				mesh.vertices, mesh.vertices_count,
+				mesh.indices, mesh.indices_count,
+				grid_resolution,
+				&level[i]
+			) ) return levels;
+
+			indices_count += static_cast<uint32>( level[i].indices.size() );
+		}
+
+		// Not worth the switch
+		if ( indices_count > previous_indices_count * MAX_KEPT_TRIANGLES_RATIO ) break;
+
+		levels.push_back( std::move( level ) );
+		previous_indices_count = indices_count;
+	}
+
+	return levels;
+}
+
+void ModelLods::add( const SharedPtr<Model>& model, const SimplifiedLevels& levels )
+{
+	if ( !model || levels.empty() ) return;
+
+	std::vector<SharedPtr<Model>>& models = _levels[model.get()];
+	models.clear();
+	models.push_back( model );
+
+	for ( const std::vector<MeshBuffers>& level : levels )
+	{
+		std::vector<SharedPtr<Mesh>> meshes;
+		meshes.reserve( level.size() );
+		for ( const MeshBuffers& buffers : level )
+		{
+			VertexArray* vertex_array = new VertexArray(
+				buffers.vertices.data(), buffers.get_vertices_count(),
+				buffers.indices.data(), static_cast<uint32>( buffers.indices.size() )
+			);
+			meshes.push_back( std::make_shared<Mesh>( vertex_array ) );
+		}
+
+		models.push_back( std::make_shared<Model>( meshes ) );
+	}
+}
+
+void ModelLods::generate( const SharedPtr<Model>& model )
+{
+	if ( !model ) return;
+
+	const int meshes_count = model->get_mesh_count();
+	std::vector<MeshBuffers> buffers( meshes_count );
+	std::vector<MeshCache::CookedMeshView> views;
+	views.reserve( meshes_count );
+	for ( int i = 0; i < meshes_count; i++ )
+	{
+		if ( !MeshBuffers::read_from( model->get_mesh( i )->get_vertex_array(), &buffers[i] ) ) return;
+
+		views.push_back(
+			MeshCache::CookedMeshView {
+				.vertices = buffers[i].vertices.data(),
+				.vertices_count = buffers[i].get_vertices_count(),
+				.indices = buffers[i].indices.data(),
+				.indices_count = static_cast<uint32>( buffers[i].indices.size() ),
+			}
+		);
+	}
+
+	add( model, simplify( views ) );
+}
+
+void ModelLods::clear()
+{
+	_levels.clear();
+}
+
+int ModelLods::get_levels_count( const Model* model )
+{
+	const auto itr = _levels.find( model );
+	if ( itr == _levels.end() ) return 1;
+
+	return static_cast<int>( itr->second.size() );
+}
+
+const SharedPtr<Model>& ModelLods::get_level( const SharedPtr<Model>& model, const int level )
+{
+	if ( level <= 0 ) return model;
+
+	const auto itr = _levels.find( model.get() );
+	if ( itr == _levels.end() ) return model;
+
+	const std::vector<SharedPtr<Model>>& models = itr->second;
+	return models[math::min( level, static_cast<int>( models.size() ) - 1 )];
+}
+
+float ModelLods::compute_screen_size( const SharedPtr<Camera>& camera, const float radius, const float distance_sqr )
+{
+	const float fov = camera->get_projection_settings().fov * math::DEG2RAD;
+	const float half_height = std::sqrt( distance_sqr ) * std::tan( fov * 0.5f );
+	if ( half_height <= 0.0f ) return 1.0f;
+
+	return radius / half_height;
+}
+
+int ModelLods::select_level( const Model* model, const float screen_size, const int current_level )
+{
+	const int max_level = get_levels_count( model ) - 1;
+	int level = math::clamp( current_level, 0, max_level );
+
+	// Coarser once clearly under the threshold of the next level
+	while ( level < max_level
+		&& screen_size < LEVEL_SCREEN_SIZES[level] * ( 1.0f - HYSTERESIS_RATIO ) )
+	{
+		level++;
+	}
+
+	// Finer once clearly over the threshold of the current level
+	while ( level > 0
+		&& screen_size > LEVEL_SCREEN_SIZES[level - 1] * ( 1.0f + HYSTERESIS_RATIO ) )
+	{
+		level--;
+	}
+
+	return level;
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include <spaceship/rendering/mesh-buffers.h>
+#include <spaceship/rendering/mesh-cache.h>
+
+#include <suprengine/components/camera.h>
+#include <suprengine/rendering/model.h>
+
+namespace spaceship
+{
+	using namespace suprengine;
+
+	/*
+	 * Registry of simplified levels of detail of models, generated when loading
+	 * them. Level 0 is the source model, each next level is coarser.
+	 *
+	 * Renderers pick a level from the screen size of the model, with hysteresis
+	 * so a model near a threshold doesn't switch back and forth between levels.
+	 */
+	class ModelLods
+	{
+	public:
+		//  Simplified buffers of a model, indexed by level minus one then by mesh
+		using SimplifiedLevels = std::vector<std::vector<MeshBuffers>>;
+
+	public:
+		/*
+		 * Simplifies meshes for each level, stopping once a level doesn't reduce
+		 * the triangles count enough. Thread-safe.
+		 */
+		static SimplifiedLevels simplify( const std::vector<MeshCache::CookedMeshView>& meshes );
+		/*
+		 * Uploads simplified levels and registers them for the model. Main thread only.
+		 */
+		static void add( const SharedPtr<Model>& model, const SimplifiedLevels& levels );
+		/*
+		 * Reads back the model buffers to simplify and register them, for models
+		 * which weren't loaded from a cooked file. Main thread only.
+		 */
+		static void generate( const SharedPtr<Model>& model );
+		static void clear();
+
+		//  Number of levels of the model, including itself
+		static int get_levels_count( const Model* model );
+		/*
+		 * Returns the model of the given level, or the model itself when it has no
+		 * simplified levels.
+		 */
+		static const SharedPtr<Model>& get_level( const SharedPtr<Model>& model, int level );
+
+		/*
+		 * Returns the ratio of the screen height covered by a sphere at the given
+		 * squared distance from the camera.
+		 */
+		static float compute_screen_size( const SharedPtr<Camera>& camera, float radius, float distance_sqr );
+		/*
+		 * Returns the level to draw at the given screen size, starting from the
+		 * current level. Levels only change once the screen size crosses their
+		 * threshold by the hysteresis ratio.
+		 */
+		static int select_level( const Model* model, float screen_size, int current_level );
+
+	public:
+		static constexpr int MAX_LEVELS_COUNT = 3;
+		//  Clustering cells along the largest axis of each simplified level
+		static constexpr int LEVEL_GRID_RESOLUTIONS[MAX_LEVELS_COUNT - 1] { 24, 10 };
+		//  Screen size under which each simplified level is used
+		static constexpr float LEVEL_SCREEN_SIZES[MAX_LEVELS_COUNT - 1] { 0.15f, 0.05f };
+		//  Relative margin around thresholds before changing level
+		static constexpr float HYSTERESIS_RATIO = 0.2f;
+		//  Maximum ratio of triangles a level must keep from the previous one
+		static constexpr float MAX_KEPT_TRIANGLES_RATIO = 0.8f;
+
+	private:
+		//  Asset data like models themselves: only filled while loading, then read by renderers
+		static std::unordered_map<const Model*, std::vector<SharedPtr<Model>>> _levels;
+	};
+}
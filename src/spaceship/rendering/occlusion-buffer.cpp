@@ -0,0 +1,118 @@
+#include "occlusion-buffer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace spaceship;
+
+OcclusionBuffer::OcclusionBuffer( const int width, const int height )
+	: _width( width ), _height( height ),
+	  _depths( static_cast<size_t>( width ) * height, std::numeric_limits<float>::max() )
+{}
+
+void OcclusionBuffer::begin( const Mtx4& view_projection, const Mtx4& projection )
+{
+	std::fill( _depths.begin(), _depths.end(), std::numeric_limits<float>::max() );
+
+	_view_projection = view_projection;
+	_scale_x = projection.mat[0][0] * 0.5f * static_cast<float>( _width );
+	_scale_y = projection.mat[1][1] * 0.5f * static_cast<float>( _height );
+}
+
+void OcclusionBuffer::add_occluder( const Vec3& center, const float radius )
+{
+	const ProjectedSphere sphere = _project( center );
+
+	// Ignore occluders around or behind the camera
+	if ( sphere.depth <= radius ) return;
+
+	// The disc at the center depth is inside the silhouette
+	const float radius_x = radius * _scale_x / sphere.depth;
+	const float radius_y = radius * _scale_y / sphere.depth;
+	if ( radius_x < 1.0f || radius_y < 1.0f ) return;
+
+	const int min_x = std::max( 0, static_cast<int>( std::ceil( sphere.x - radius_x ) ) );
+	const int max_x = std::min( _width - 1, static_cast<int>( std::floor( sphere.x + radius_x ) ) - 1 );
+	const int min_y = std::max( 0, static_cast<int>( std::ceil( sphere.y - radius_y ) ) );
+	const int max_y = std::min( _height - 1, static_cast<int>( std::floor( sphere.y + radius_y ) ) - 1 );
+
+	const float far_depth = sphere.depth + radius;
+	const float inverse_radius_x_sqr = 1.0f / ( radius_x * radius_x );
+	const float inverse_radius_y_sqr = 1.0f / ( radius_y * radius_y );
+
+	for ( int y = min_y; y <= max_y; y++ )
+	{
+		// Farthest pixel edge from the center
+		const float offset_y = std::max(
+			std::abs( static_cast<float>( y ) - sphere.y ),
+			std::abs( static_cast<float>( y + 1 ) - sphere.y )
+		);
+		const float distance_y = offset_y * offset_y * inverse_radius_y_sqr;
+		if ( distance_y > 1.0f ) continue;
+
+		float* row = &_depths[y * _width];
+		for ( int x = min_x; x <= max_x; x++ )
+		{
+			const float offset_x = std::max(
+				std::abs( static_cast<float>( x ) - sphere.x ),
+				std::abs( static_cast<float>( x + 1 ) - sphere.x )
+			);
+
+			// Only write pixels fully covered by the disc
+			if ( offset_x * offset_x * inverse_radius_x_sqr + distance_y > 1.0f ) continue;
+
+			row[x] = std::min( row[x], far_depth );
+		}
+	}
+}
+
+bool OcclusionBuffer::is_sphere_occluded( const Vec3& center, const float radius ) const
+{
+	const ProjectedSphere sphere = _project( center );
+
+	// Spheres crossing the near plane are always visible
+	const float near_depth = sphere.depth - radius;
+	if ( near_depth <= 0.0f ) return false;
+
+	// Enclosing rectangle of the silhouette
+	const float radius_x = radius * _scale_x / near_depth;
+	const float radius_y = radius * _scale_y / near_depth;
+
+	const int min_x = std::max( 0, static_cast<int>( std::floor( sphere.x - radius_x ) ) );
+	const int max_x = std::min( _width - 1, static_cast<int>( std::floor( sphere.x + radius_x ) ) );
+	const int min_y = std::max( 0, static_cast<int>( std::floor( sphere.y - radius_y ) ) );
+	const int max_y = std::min( _height - 1, static_cast<int>( std::floor( sphere.y + radius_y ) ) );
+
+	// Outside of the screen, left to the frustum culling
+	if ( min_x > max_x || min_y > max_y ) return false;
+
+	for ( int y = min_y; y <= max_y; y++ )
+	{
+		const float* row = &_depths[y * _width];
+		for ( int x = min_x; x <= max_x; x++ )
+		{
+			if ( row[x] >= near_depth ) return false;
+		}
+	}
+
+	return true;
+}
+
+OcclusionBuffer::ProjectedSphere OcclusionBuffer::_project( const Vec3& center ) const
+{
+	const auto& mat = _view_projection.mat;
+
+	const float clip_x = center.x * mat[0][0] + center.y * mat[1][0] + center.z * mat[2][0] + mat[3][0];
+	const float clip_y = center.x * mat[0][1] + center.y * mat[1][1] + center.z * mat[2][1] + mat[3][1];
+	const float clip_w = center.x * mat[0][3] + center.y * mat[1][3] + center.z * mat[2][3] + mat[3][3];
+
+	ProjectedSphere sphere {};
+	sphere.depth = clip_w;
+	if ( clip_w > 0.0f )
+	{
+		sphere.x = ( clip_x / clip_w * 0.5f + 0.5f ) * static_cast<float>( _width );
+		sphere.y = ( clip_y / clip_w * 0.5f + 0.5f ) * static_cast<float>( _height );
+	}
+	return sphere;
+}
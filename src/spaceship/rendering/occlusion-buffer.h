@@ -0,0 +1,61 @@
+#pragma once
+
+#include <vector>
+
+#include <suprengine/math/mtx4.h>
+#include <suprengine/math/vec3.h>
+
+namespace spaceship
+{
+	using namespace suprengine;
+
+	/*
+	 * Low-resolution depth buffer rasterized on the CPU from occluder spheres,
+	 * used to skip draws of objects entirely hidden behind them.
+	 *
+	 * Both sides are conservative: occluders write the disc of their sphere at its
+	 * farthest depth, only on pixels fully covered, while occludees are tested on
+	 * a rectangle enclosing their silhouette at their nearest depth. Occluder
+	 * spheres must be fully inside the geometry they stand for.
+	 *
+	 * Depths are linear, taken from the clip-space w of a perspective projection.
+	 */
+	class OcclusionBuffer
+	{
+	public:
+		OcclusionBuffer( int width = 128, int height = 72 );
+
+		/*
+		 * Clears the buffer and sets the camera matrices used to project spheres.
+		 */
+		void begin( const Mtx4& view_projection, const Mtx4& projection );
+
+		void add_occluder( const Vec3& center, float radius );
+		bool is_sphere_occluded( const Vec3& center, float radius ) const;
+
+		int get_width() const { return _width; }
+		int get_height() const { return _height; }
+		const std::vector<float>& get_depths() const { return _depths; }
+
+	private:
+		struct ProjectedSphere
+		{
+			//  Center in pixels
+			float x, y;
+			//  Linear depth of the center
+			float depth;
+		};
+
+		ProjectedSphere _project( const Vec3& center ) const;
+
+	private:
+		int _width = 0;
+		int _height = 0;
+		std::vector<float> _depths;
+
+		Mtx4 _view_projection;
+		//  Projection scales converting a size at a depth into pixels
+		float _scale_x = 0.0f;
+		float _scale_y = 0.0f;
+	};
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <vector>
+
+#include <suprengine/components/camera.h>
+
+namespace spaceship
+{
+	using namespace suprengine;
+
+	/*
+	 * State of a renderer kept separately for each camera, since renderers are
+	 * rendered once per camera every frame, e.g. with split-screen viewports.
+	 *
+	 * Cameras are identified by address: a new camera re-using the address of a
+	 * destroyed one inherits its state, which is only a hint such as a level of
+	 * detail. The least recently added camera is forgotten when full.
+	 */
+	template <typename T>
+	class PerCameraState
+	{
+	public:
+		T& get( const Camera* camera )
+		{
+			for ( Entry& entry : _entries )
+			{
+				if ( entry.camera == camera ) return entry.state;
+			}
+
+			if ( static_cast<int>( _entries.size() ) >= MAX_CAMERAS_COUNT )
+			{
+				_entries.erase( _entries.begin() );
+			}
+
+			_entries.push_back( Entry { camera, T {} } );
+			return _entries.back().state;
+		}
+
+	public:
+		//  Four split-screen players, plus room for debug cameras
+		static constexpr int MAX_CAMERAS_COUNT = 8;
+
+	private:
+		struct Entry
+		{
+			const Camera* camera;
+			T state;
+		};
+
+	private:
+		std::vector<Entry> _entries;
+	};
+}
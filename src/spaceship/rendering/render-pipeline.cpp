@@ -0,0 +1,87 @@
+#include "render-pipeline.h"
+
+#include <spaceship/rendering/frustum.h>
+
+using namespace spaceship;
+
+RenderPipeline::RenderPipeline( const bool is_threaded )
+	: _is_threaded( is_threaded ),
+	  _render_thread( is_threaded ? 1 : 0 )
+{}
+
+RenderSnapshot* RenderPipeline::exchange(
+	const Camera* camera,
+	const CameraSnapshot& camera_state,
+	InstancedDrawList& draw_list,
+	const bool is_occlusion_culling_enabled
+)
+{
+	std::unique_ptr<CameraSlots>& slots_ptr = _slots[camera];
+	if ( !slots_ptr )
+	{
+		slots_ptr = std::make_unique<CameraSlots>();
+	}
+	CameraSlots& slots = *slots_ptr;
+
+	// The write slot has been submitted and cleared last frame, swap its storage
+	RenderSnapshot& write_snapshot = slots.snapshots[slots.write_index];
+	std::swap( write_snapshot.draw_list, draw_list );
+	write_snapshot.camera = camera_state;
+	write_snapshot.is_occlusion_culling_enabled = is_occlusion_culling_enabled;
+	write_snapshot.is_submitted = true;
+
+	if ( !_is_threaded )
+	{
+		_prepare( write_snapshot );
+		write_snapshot.is_prepared = true;
+		return &write_snapshot;
+	}
+
+	{
+		std::lock_guard lock( _mutex );
+		write_snapshot.is_prepared = false;
+	}
+	_render_thread.submit(
+		[this, &write_snapshot]
+		{
+			_prepare( write_snapshot );
+
+			{
+				std::lock_guard lock( _mutex );
+				write_snapshot.is_prepared = true;
+			}
+			_prepared_condition.notify_all();
+		}
+	);
+
+	// Submit the previous frame, which the render thread should be done with
+	RenderSnapshot& read_snapshot = slots.snapshots[1 - slots.write_index];
+	slots.write_index = 1 - slots.write_index;
+	if ( !read_snapshot.is_submitted ) return nullptr;
+
+	std::unique_lock lock( _mutex );
+	_prepared_condition.wait( lock, [&read_snapshot] { return read_snapshot.is_prepared; } );
+	return &read_snapshot;
+}
+
+void RenderPipeline::_prepare( RenderSnapshot& snapshot )
+{
+	const CameraSnapshot& camera = snapshot.camera;
+	InstancedDrawList& draw_list = snapshot.draw_list;
+	if ( draw_list.get_instances_count() == 0 ) return;
+
+	// Rasterize occluders of this camera
+	const OcclusionBuffer* occlusion_buffer = nullptr;
+	if ( snapshot.is_occlusion_culling_enabled && !draw_list.get_occluders().empty() )
+	{
+		_occlusion_buffer.begin( camera.view_projection, camera.projection );
+		for ( const OccluderSphere& occluder : draw_list.get_occluders() )
+		{
+			_occlusion_buffer.add_occluder( occluder.center, occluder.radius );
+		}
+		occlusion_buffer = &_occlusion_buffer;
+	}
+
+	// Only submit what this camera can see
+	draw_list.cull( Frustum::from_view_projection( camera.view_projection ), occlusion_buffer );
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include <spaceship/rendering/instanced-draw-list.h>
+#include <spaceship/rendering/occlusion-buffer.h>
+#include <spaceship/utils/worker-pool.h>
+
+#include <suprengine/components/camera.h>
+
+namespace spaceship
+{
+	using namespace suprengine;
+
+	//  Camera state captured along with the draws of a frame
+	struct CameraSnapshot
+	{
+		Mtx4 view_projection;
+		Mtx4 projection;
+	};
+
+	/*
+	 * Draws of a frame for one camera, as collected by renderers, then culled and
+	 * sorted by the render thread.
+	 */
+	struct RenderSnapshot
+	{
+		CameraSnapshot camera {};
+		InstancedDrawList draw_list;
+		bool is_occlusion_culling_enabled = true;
+
+		//  Whether the snapshot holds a frame, false until the first one
+		bool is_submitted = false;
+		//  Whether the render thread is done with it, guarded by the pipeline
+		bool is_prepared = false;
+	};
+
+	/*
+	 * Double-buffers render snapshots per camera: while the render thread culls
+	 * the draws of the current frame, the main thread submits those of the
+	 * previous frame to OpenGL. Rendering has one frame of latency, in exchange
+	 * for the culling cost overlapping with the next simulation frame.
+	 *
+	 * OpenGL calls stay on the main thread, which owns the context.
+	 */
+	class RenderPipeline
+	{
+	public:
+		explicit RenderPipeline( bool is_threaded );
+
+		/*
+		 * Takes the draws collected for the camera, leaving an empty list in
+		 * place, and returns the snapshot to submit for this camera. When threaded,
+		 * it is the one of the previous frame, waiting for the render thread if
+		 * needed, otherwise it is prepared immediately. Returns null when there is
+		 * no frame to submit yet.
+		 *
+		 * The returned draw list must be cleared once submitted.
+		 */
+		RenderSnapshot* exchange(
+			const Camera* camera,
+			const CameraSnapshot& camera_state,
+			InstancedDrawList& draw_list,
+			bool is_occlusion_culling_enabled
+		);
+
+		bool is_threaded() const { return _is_threaded; }
+
+	private:
+		struct CameraSlots
+		{
+			RenderSnapshot snapshots[2];
+			int write_index = 0;
+		};
+
+	private:
+		void _prepare( RenderSnapshot& snapshot );
+
+	private:
+		bool _is_threaded = false;
+
+		std::unordered_map<const Camera*, std::unique_ptr<CameraSlots>> _slots;
+
+		std::mutex _mutex;
+		std::condition_variable _prepared_condition;
+
+		//  Only used by the render thread, or the main thread when not threaded
+		OcclusionBuffer _occlusion_buffer;
+
+		//  Destroyed first, so pending snapshots are prepared before their slots are freed
+		WorkerPool _render_thread;
+	};
+}
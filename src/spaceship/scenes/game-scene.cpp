@@ -1,8 +1,9 @@
 #include "game-scene.h"
 
 #include <spaceship/game-instance.h>
-#include <spaceship/entities/explosion-effect.h>
+#include <spaceship/match-setup.h>
 #include <spaceship/components/player-hud.h>
+#include <spaceship/world.h>
 
 #include <suprengine/core/assets.h>
 
@@ -12,43 +13,23 @@ using namespace spaceship;
 
 GameScene::GameScene( GameInstance* game_instance )
 	: _game_instance( game_instance )
-{
-}
+{}
+
+// Handles on entities are released before the world destroying them
+GameScene::~GameScene() = default;
 
 void GameScene::init()
 {
 	Engine& engine = Engine::instance();
+	const GameLaunchSettings& launch_settings = _game_instance->get_launch_settings();
 
-	random::seed( _seed );
-
-	// Setup planet
-	const SharedPtr<Entity> planet = engine.create_entity<Entity>();
-	planet->transform->location = Vec3 { 2000.0f, 500.0f, 30.0f };
-	planet->transform->rotation = Quaternion( DegAngles { -6.0f, 0.0f, 12.0f } );
-	planet->transform->scale = Vec3( 10.0f );
-	planet->create_component<StylizedModelRenderer>(
-		Assets::get_model( "planet-ring" ),
-		Color::from_0x( 0x1c6cF0FF )
-	);
+	_world = MatchSetup::create_world( launch_settings, _game_instance->get_match_resources() );
+	_world->should_interpolate_transforms = !launch_settings.is_headless;
 
-	// Spawn asteroids
-	constexpr int ASTEROID_COUNT = 32;
-	constexpr Vec3 ASTEROIDS_LOCATION { 500.0f, 100.0f, 50.0f };
-
-	for ( int i = 0; i < ASTEROID_COUNT; i++ )
-	{
-		const SharedPtr<Asteroid> asteroid = engine.create_entity<Asteroid>();
-		asteroid->transform->location = ASTEROIDS_LOCATION + random::generate_location(
-			-300.0f, -300.0f, -300.0f,
-			300.0f, 300.0f, 300.0f
-		);
-		asteroid->transform->rotation = Quaternion::look_at( random::generate_direction(), Vec3::up );
-		asteroid->transform->scale = random::generate_scale( 4.0f, 30.0f );
-		asteroid->linear_direction = Vec3::right * 2.0f * random::generate( 0.8f, 1.2f );
-		asteroid->update_collision_to_transform();
-	}
+	// Headless simulation has no inputs nor cameras, only AIs are spawned
+	if ( launch_settings.is_headless ) return;
 
-	_player_manager = std::make_unique<PlayerManager>( *engine.get_inputs() );
+	_player_manager = std::make_unique<PlayerManager>( *_world, *engine.get_inputs() );
 
 	// Spawn first player
 	const SharedPtr<PlayerSpaceshipController> player_controller = _player_manager->create_player( _player_location, _player_rotation, 0 );
@@ -56,13 +37,13 @@ void GameScene::init()
 	_player_controller = player_controller;
 
 	// Spawn second spaceship
-	const SharedPtr<Spaceship> spaceship2 = engine.create_entity<Spaceship>();
+	const SharedPtr<Spaceship> spaceship2 = _world->create_entity<Spaceship>();
 	spaceship2->set_color( Color::from_0x( 0x9213f2FF ) );
 	spaceship2->transform->location = Vec3 { 50.0f, 0.0f, 0.0f };
 	_spaceship2 = spaceship2;
 
 	// Possess it by AI
-	const SharedPtr<AISpaceshipController> ai_controller = engine.create_entity<AISpaceshipController>();
+	const SharedPtr<AISpaceshipController> ai_controller = _world->create_entity<AISpaceshipController>();
 	ai_controller->possess( spaceship2 );
 	_ai_controller = ai_controller;
 	//ai_controller->wk_target = spaceship1;
@@ -72,7 +53,7 @@ void GameScene::init()
 	projection_settings.fov = 50.0f;
 	projection_settings.znear = 10.0f;
 
-	const SharedPtr<Entity> camera_owner = engine.create_entity<Entity>();
+	const SharedPtr<Entity> camera_owner = _world->create_entity<Entity>();
 	_temporary_camera = camera_owner->create_component<Camera>( projection_settings );
 	_temporary_camera_model = camera_owner->create_component<ModelRenderer>( Assets::get_model( MESH_ARROW ) );
 
@@ -81,6 +62,31 @@ void GameScene::init()
 
 void GameScene::update( const float dt )
 {
+	// Simulate from the last ticked transforms, not the ones interpolated for rendering
+	_world->restore_transforms();
+
+	// AIs far from any player camera plan less often
+	_world->viewer_locations.clear();
+	if ( _player_manager )
+	{
+		for ( int i = 0; i < _player_manager->get_players_count(); i++ )
+		{
+			_world->viewer_locations.push_back( _player_manager->get_camera( i )->transform->location );
+		}
+	}
+
+	// Tick at a fixed rate, independently of the frame rate
+	_timestep.accumulate( dt );
+	while ( _timestep.consume_step() )
+	{
+		_world->update( _timestep.get_step_time() );
+	}
+
+	// Render between the last two ticks, for motion to stay smooth at any frame rate
+	_world->interpolate_transforms( _timestep.get_interpolation_alpha() );
+
+	if ( _game_instance->get_launch_settings().is_headless ) return;
+
 	Engine& engine = Engine::instance();
 	const InputManager* inputs = engine.get_inputs();
 
@@ -116,7 +122,7 @@ void GameScene::update( const float dt )
 
 	if ( ( spawn_time -= dt ) <= 0.0f )
 	{
-		SharedPtr<ExplosionEffect> explosion = engine.create_entity<ExplosionEffect>(
+		SharedPtr<ExplosionEffect> explosion = _world->get_explosions_pool().acquire(
 			15.0f,
 			random::generate_color()
 		);
@@ -183,52 +189,22 @@ void GameScene::update( const float dt )
 		const int count = random::generate( 7, 14 );
 		for ( int i = 0; i < count; i++ )
 		{
-			TIMER( i * random::generate( 0.1f, 0.25f ), {
+			_world->add_timer( i * random::generate( 0.1f, 0.25f ), [this] {
 				const SharedPtr<Spaceship> spaceship = player_controller->get_ship();
 
-				const SharedPtr<ExplosionEffect> effect = engine.create_entity<ExplosionEffect>(
+				const SharedPtr<ExplosionEffect> effect = _world->get_explosions_pool().acquire(
 					random::generate( 15.0f, 20.0f ), 
 					random::generate_color() 
 				);
 				effect->transform->location = 
 					spaceship->transform->location 
 					+ random::generate_direction() * random::generate( 100.0f, 200.0f );
-			} );
+			}, player_controller );
 		}
 	}*/
 }
 
 void GameScene::generate_ai_spaceships( const int count )
 {
-	Engine& engine = Engine::instance();
-
-	std::vector<SharedPtr<Spaceship>> potential_targets;
-	std::vector<SharedPtr<AISpaceshipController>> controllers;
-
-	for ( int i = 0; i < count; i++ )
-	{
-		auto spaceship = engine.create_entity<Spaceship>();
-		spaceship->set_color( random::generate_color() );
-		spaceship->transform->location = Vec3 
-		{ 
-			100.0f + static_cast<float>( i ) * 50.0f,
-			0.0f,
-			0.0f
-		};
-		potential_targets.push_back( spaceship );
-
-		auto controller = engine.create_entity<AISpaceshipController>();
-		controller->possess( spaceship );
-		controllers.push_back( controller );
-	}
-
-	std::random_device rd {};
-	std::default_random_engine rng( rd() );
-	std::shuffle( potential_targets.begin(), potential_targets.end(), rng );
-
-	for ( const SharedPtr<AISpaceshipController>& controller : controllers )
-	{
-		controller->wk_target = potential_targets[potential_targets.size() - 1];
-		potential_targets.pop_back();
-	}
+	MatchSetup::spawn_ai_spaceships( *_world, count );
 }
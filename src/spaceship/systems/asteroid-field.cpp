@@ -0,0 +1,400 @@
+#include "asteroid-field.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined( __AVX__ )
+	#include <immintrin.h>
+	#define SPACESHIP_ASTEROID_FIELD_AVX
+#endif
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+	#include <emmintrin.h>
+	#define SPACESHIP_ASTEROID_FIELD_SSE
+#endif
+
+#include <spaceship/components/asteroid-field-renderer.h>
+#include <spaceship/physics/collision-broadphase.h>
+#include <spaceship/utils/job-system.h>
+#include <spaceship/utils/simulation-checksum.h>
+
+
+using namespace spaceship;
+
+namespace
+{
+	struct AsteroidArrays
+	{
+		float* location_x;
+		float* location_y;
+		float* location_z;
+		const float* direction_x;
+		const float* direction_y;
+		const float* direction_z;
+		float* rotation_x;
+		float* rotation_y;
+		float* rotation_z;
+		float* rotation_w;
+	};
+
+	/*
+	 * Operations on a lane of floats. Every instruction set goes through the same
+	 * integration code, so the order of operations, and thus the results, are
+	 * strictly identical.
+	 */
+	struct ScalarLane
+	{
+		using Type = float;
+		static constexpr int WIDTH = 1;
+
+		static Type set( const float value ) { return value; }
+		static Type load( const float* data ) { return *data; }
+		static void store( float* data, const Type value ) { *data = value; }
+		static Type add( const Type lhs, const Type rhs ) { return lhs + rhs; }
+		static Type sub( const Type lhs, const Type rhs ) { return lhs - rhs; }
+		static Type mul( const Type lhs, const Type rhs ) { return lhs * rhs; }
+		static Type div( const Type lhs, const Type rhs ) { return lhs / rhs; }
+		static Type sqrt( const Type value ) { return std::sqrt( value ); }
+	};
+
+#ifdef SPACESHIP_ASTEROID_FIELD_SSE
+	struct SSELane
+	{
+		using Type = __m128;
+		static constexpr int WIDTH = 4;
+
+		static Type set( const float value ) { return _mm_set1_ps( value ); }
+		static Type load( const float* data ) { return _mm_loadu_ps( data ); }
+		static void store( float* data, const Type value ) { _mm_storeu_ps( data, value ); }
+		static Type add( const Type lhs, const Type rhs ) { return _mm_add_ps( lhs, rhs ); }
+		static Type sub( const Type lhs, const Type rhs ) { return _mm_sub_ps( lhs, rhs ); }
+		static Type mul( const Type lhs, const Type rhs ) { return _mm_mul_ps( lhs, rhs ); }
+		static Type div( const Type lhs, const Type rhs ) { return _mm_div_ps( lhs, rhs ); }
+		static Type sqrt( const Type value ) { return _mm_sqrt_ps( value ); }
+	};
+#endif
+
+#ifdef SPACESHIP_ASTEROID_FIELD_AVX
+	struct AVXLane
+	{
+		using Type = __m256;
+		static constexpr int WIDTH = 8;
+
+		static Type set( const float value ) { return _mm256_set1_ps( value ); }
+		static Type load( const float* data ) { return _mm256_loadu_ps( data ); }
+		static void store( float* data, const Type value ) { _mm256_storeu_ps( data, value ); }
+		static Type add( const Type lhs, const Type rhs ) { return _mm256_add_ps( lhs, rhs ); }
+		static Type sub( const Type lhs, const Type rhs ) { return _mm256_sub_ps( lhs, rhs ); }
+		static Type mul( const Type lhs, const Type rhs ) { return _mm256_mul_ps( lhs, rhs ); }
+		static Type div( const Type lhs, const Type rhs ) { return _mm256_div_ps( lhs, rhs ); }
+		static Type sqrt( const Type value ) { return _mm256_sqrt_ps( value ); }
+	};
+#endif
+
+	/*
+	 * Integrates asteroids from the first index while a full lane fits before the
+	 * end index. Returns the index of the first asteroid left to integrate.
+	 */
+	template <typename Lane>
+	int integrate_lanes( const AsteroidArrays& arrays, int index, const int end, const float dt )
+	{
+		using Type = typename Lane::Type;
+
+		const Type delta_time = Lane::set( dt );
+		// Half of the angular velocity, converted from degrees per second
+		const Type half_angle_factor = Lane::set( math::DEG2RAD * 0.5f * dt );
+
+		for ( ; index + Lane::WIDTH <= end; index += Lane::WIDTH )
+		{
+			const Type direction_x = Lane::load( arrays.direction_x + index );
+			const Type direction_y = Lane::load( arrays.direction_y + index );
+			const Type direction_z = Lane::load( arrays.direction_z + index );
+
+			// Location
+			Lane::store( arrays.location_x + index, Lane::add( Lane::load( arrays.location_x + index ), Lane::mul( direction_x, delta_time ) ) );
+			Lane::store( arrays.location_y + index, Lane::add( Lane::load( arrays.location_y + index ), Lane::mul( direction_y, delta_time ) ) );
+			Lane::store( arrays.location_z + index, Lane::add( Lane::load( arrays.location_z + index ), Lane::mul( direction_z, delta_time ) ) );
+
+			// Rotation: q += 0.5 * dt * ( w * q ), with w the angular velocity
+			const Type wx = Lane::mul( direction_x, half_angle_factor );
+			const Type wy = Lane::mul( direction_y, half_angle_factor );
+			const Type wz = Lane::mul( direction_z, half_angle_factor );
+
+			const Type qx = Lane::load( arrays.rotation_x + index );
+			const Type qy = Lane::load( arrays.rotation_y + index );
+			const Type qz = Lane::load( arrays.rotation_z + index );
+			const Type qw = Lane::load( arrays.rotation_w + index );
+
+			const Type nx = Lane::add( qx, Lane::sub( Lane::add( Lane::mul( wx, qw ), Lane::mul( wy, qz ) ), Lane::mul( wz, qy ) ) );
+			const Type ny = Lane::add( qy, Lane::sub( Lane::add( Lane::mul( wy, qw ), Lane::mul( wz, qx ) ), Lane::mul( wx, qz ) ) );
+			const Type nz = Lane::add( qz, Lane::sub( Lane::add( Lane::mul( wz, qw ), Lane::mul( wx, qy ) ), Lane::mul( wy, qx ) ) );
+			const Type nw = Lane::sub( qw, Lane::add( Lane::add( Lane::mul( wx, qx ), Lane::mul( wy, qy ) ), Lane::mul( wz, qz ) ) );
+
+			// Re-normalize, with an exact square root to stay deterministic across CPUs
+			const Type length = Lane::sqrt(
+				Lane::add(
+					Lane::add( Lane::mul( nx, nx ), Lane::mul( ny, ny ) ),
+					Lane::add( Lane::mul( nz, nz ), Lane::mul( nw, nw ) )
+				)
+			);
+			Lane::store( arrays.rotation_x + index, Lane::div( nx, length ) );
+			Lane::store( arrays.rotation_y + index, Lane::div( ny, length ) );
+			Lane::store( arrays.rotation_z + index, Lane::div( nz, length ) );
+			Lane::store( arrays.rotation_w + index, Lane::div( nw, length ) );
+		}
+
+		return index;
+	}
+}
+
+void AsteroidField::setup()
+{
+	_renderer = create_component<AsteroidFieldRenderer>( as<AsteroidField>() );
+
+	CollisionBroadphase::register_body_source( *_world, as<AsteroidField>() );
+	SimulationChecksum::track(
+		*_world,
+		as<Entity>(),
+		nullptr,
+		[this]( SimulationChecksum& checksum ) { _hash_state( checksum ); }
+	);
+}
+
+void AsteroidField::update_this( const float dt )
+{
+	// Without broadphase, nothing refers to asteroids by index
+	if ( _world->wk_broadphase.expired() )
+	{
+		_apply_pending_removals();
+	}
+
+	// Asteroids are independent, chunks are multiple of all lanes widths
+	JobSystem::run_parallel( _world->job_system, get_count(), INTEGRATE_CHUNK_SIZE,
+		[this, dt]( int, const int begin, const int end )
+		{
+			_integrate( begin, end - begin, dt );
+		}
+	);
+}
+
+int AsteroidField::spawn( const AsteroidSpawnInfo& info )
+{
+	_location_x.push_back( info.location.x );
+	_location_y.push_back( info.location.y );
+	_location_z.push_back( info.location.z );
+	_direction_x.push_back( info.linear_direction.x );
+	_direction_y.push_back( info.linear_direction.y );
+	_direction_z.push_back( info.linear_direction.z );
+	_rotation_x.push_back( info.rotation.x );
+	_rotation_y.push_back( info.rotation.y );
+	_rotation_z.push_back( info.rotation.z );
+	_rotation_w.push_back( info.rotation.w );
+	_scale_x.push_back( info.scale.x );
+	_scale_y.push_back( info.scale.y );
+	_scale_z.push_back( info.scale.z );
+
+	_healths.push_back( HEALTH_PER_SCALE * info.scale.x );
+	_split_times.push_back( info.split_times );
+	_model_ids.push_back( static_cast<uint8>( _world->random.generate( 0, MODELS_COUNT - 1 ) ) );
+
+	return get_count() - 1;
+}
+
+void AsteroidField::split( const int index )
+{
+	_split_times[index]--;
+
+	// Copy the state since spawning may re-allocate the arrays
+	const Vec3 location = get_location( index );
+	const Quaternion rotation = get_rotation( index );
+	const Vec3 scale = get_scale( index );
+	const int split_times = _split_times[index];
+
+	const float linear_force = Vec3 {
+		_direction_x[index],
+		_direction_y[index],
+		_direction_z[index]
+	}.length();
+
+	// Spread pieces evenly around the asteroid
+	const int count = _world->random.generate( 2, 4 );
+	for ( int i = 0; i < count; i++ )
+	{
+		const float angle = math::DOUBLE_PI * static_cast<float>( i ) / static_cast<float>( count );
+
+		AsteroidSpawnInfo info {};
+		info.linear_direction = Vec3::transform( 
+			Vec3 { 
+				math::cos( angle ), 
+				math::sin( angle ), 
+				0.0f 
+			}, 
+			rotation
+		) * linear_force * _world->random.generate( 1.1f, 1.5f );
+		info.location = location + info.linear_direction.normalized();
+		info.rotation = Quaternion::look_at( 
+			_world->random.generate_direction(), 
+			Vec3::up 
+		);
+		info.scale = scale * ( _world->random.generate( 0.9f, 1.2f ) / static_cast<float>( count ) );
+		info.split_times = split_times;
+		spawn( info );
+	}
+}
+
+void AsteroidField::gather_collision_spheres( std::vector<CollisionSphere>& spheres )
+{
+	// The broadphase is about to be rebuilt, indices it knows can now change
+	_apply_pending_removals();
+
+	const int count = get_count();
+	for ( int i = 0; i < count; i++ )
+	{
+		if ( _healths[i] <= 0.0f ) continue;
+
+		const float max_scale = math::max( _scale_x[i], math::max( _scale_y[i], _scale_z[i] ) );
+		spheres.push_back(
+			CollisionSphere {
+				.center = get_location( i ),
+				.radius = COLLISION_RADIUS * max_scale,
+				.body_index = i,
+			}
+		);
+	}
+}
+
+DamageResult AsteroidField::damage_body( const int index, const DamageInfo& info )
+{
+	DamageResult result( info );
+
+	// Results of queries made before the last gathering are outdated
+	if ( index < 0 || index >= get_count() ) return result;
+
+	// Same checks as a health component
+	if ( _healths[index] <= 0.0f ) return result;
+	if ( info.attacker == nullptr ) return result;
+	if ( info.damage <= 0.0f ) return result;
+
+	_healths[index] -= info.damage;
+
+	result.is_valid = true;
+	result.is_alive = _healths[index] > 0.0f;
+
+	// Knockback
+	const float knockback_ratio = 1.0f / _scale_x[index];
+	_direction_x[index] += info.knockback.x * knockback_ratio;
+	_direction_y[index] += info.knockback.y * knockback_ratio;
+	_direction_z[index] += info.knockback.z * knockback_ratio;
+
+	// Check death
+	if ( !result.is_alive )
+	{
+		// Split in multiple asteroids
+		if ( _split_times[index] > 0 )
+		{
+			split( index );
+		}
+
+		_pending_removals.push_back( index );
+	}
+
+	return result;
+}
+
+Vec3 AsteroidField::get_location( const int index ) const
+{
+	return Vec3 { _location_x[index], _location_y[index], _location_z[index] };
+}
+
+Quaternion AsteroidField::get_rotation( const int index ) const
+{
+	return Quaternion { _rotation_x[index], _rotation_y[index], _rotation_z[index], _rotation_w[index] };
+}
+
+Vec3 AsteroidField::get_scale( const int index ) const
+{
+	return Vec3 { _scale_x[index], _scale_y[index], _scale_z[index] };
+}
+
+void AsteroidField::_integrate( const int first, const int count, const float dt )
+{
+	const AsteroidArrays arrays {
+		.location_x = _location_x.data(),
+		.location_y = _location_y.data(),
+		.location_z = _location_z.data(),
+		.direction_x = _direction_x.data(),
+		.direction_y = _direction_y.data(),
+		.direction_z = _direction_z.data(),
+		.rotation_x = _rotation_x.data(),
+		.rotation_y = _rotation_y.data(),
+		.rotation_z = _rotation_z.data(),
+		.rotation_w = _rotation_w.data(),
+	};
+
+	const int end = first + count;
+	int index = first;
+
+	// Widest lanes first, remaining asteroids go through narrower ones
+#ifdef SPACESHIP_ASTEROID_FIELD_AVX
+	index = integrate_lanes<AVXLane>( arrays, index, end, dt );
+#endif
+#ifdef SPACESHIP_ASTEROID_FIELD_SSE
+	index = integrate_lanes<SSELane>( arrays, index, end, dt );
+#endif
+	integrate_lanes<ScalarLane>( arrays, index, end, dt );
+}
+
+void AsteroidField::_remove( const int index )
+{
+	// Swap with the last asteroid to keep arrays contiguous
+	const auto swap_remove = [index]( auto& array )
+	{
+		array[index] = array.back();
+		array.pop_back();
+	};
+
+	swap_remove( _location_x );
+	swap_remove( _location_y );
+	swap_remove( _location_z );
+	swap_remove( _direction_x );
+	swap_remove( _direction_y );
+	swap_remove( _direction_z );
+	swap_remove( _rotation_x );
+	swap_remove( _rotation_y );
+	swap_remove( _rotation_z );
+	swap_remove( _rotation_w );
+	swap_remove( _scale_x );
+	swap_remove( _scale_y );
+	swap_remove( _scale_z );
+	swap_remove( _healths );
+	swap_remove( _split_times );
+	swap_remove( _model_ids );
+}
+
+void AsteroidField::_apply_pending_removals()
+{
+	if ( _pending_removals.empty() ) return;
+
+	// Remove from the end so swapped asteroids are never pending ones
+	std::sort( _pending_removals.begin(), _pending_removals.end(), std::greater<int>() );
+	const auto last = std::unique( _pending_removals.begin(), _pending_removals.end() );
+
+	for ( auto itr = _pending_removals.begin(); itr != last; ++itr )
+	{
+		_remove( *itr );
+	}
+
+	_pending_removals.clear();
+}
+
+void AsteroidField::_hash_state( SimulationChecksum& checksum ) const
+{
+	const int count = get_count();
+	checksum.add( static_cast<uint32>( count ) );
+
+	for ( int i = 0; i < count; i++ )
+	{
+		checksum.add( get_location( i ) );
+		checksum.add( get_rotation( i ) );
+		checksum.add( _healths[i] );
+	}
+}
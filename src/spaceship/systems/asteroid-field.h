@@ -0,0 +1,97 @@
+#pragma once
+
+#include <vector>
+
+#include <spaceship/physics/collision-body-source.h>
+#include <spaceship/world.h>
+
+#include <suprengine/core/entity.h>
+
+namespace spaceship
+{
+	using namespace suprengine;
+
+	class AsteroidFieldRenderer;
+	class SimulationChecksum;
+
+	struct AsteroidSpawnInfo
+	{
+		Vec3 location = Vec3::zero;
+		Quaternion rotation = Quaternion::identity;
+		Vec3 scale = Vec3::one;
+
+		//  Linear velocity, also used as angular velocity in degrees per second
+		Vec3 linear_direction = Vec3::forward * 5.0f;
+
+		int split_times = 2;
+	};
+
+	/*
+	 * Stores asteroids location, rotation, scale and linear direction in
+	 * structure-of-arrays and integrates them with SIMD instructions when available
+	 * (AVX, then SSE, with a scalar fallback). All code paths compute bit-identical
+	 * results so simulation checksums don't depend on the instruction set.
+	 *
+	 * Asteroids are damaged through the broadphase as collision bodies.
+	 */
+	class AsteroidField : public WorldEntity, public CollisionBodySource
+	{
+	public:
+		void setup() override;
+		void update_this( float dt ) override;
+
+		int spawn( const AsteroidSpawnInfo& info );
+		void split( int index );
+
+		void gather_collision_spheres( std::vector<CollisionSphere>& spheres ) override;
+		DamageResult damage_body( int index, const DamageInfo& info ) override;
+
+		int get_count() const { return static_cast<int>( _location_x.size() ); }
+		bool is_alive( int index ) const { return _healths[index] > 0.0f; }
+
+		Vec3 get_location( int index ) const;
+		Quaternion get_rotation( int index ) const;
+		Vec3 get_scale( int index ) const;
+		int get_model_id( int index ) const { return _model_ids[index]; }
+
+	public:
+		//  Number of different asteroid models
+		static constexpr int MODELS_COUNT = 2;
+
+		//  Color of all asteroids
+		const Color COLOR = Color::from_0x( 0xeb6e3dFF );
+
+	private:
+		void _integrate( int first, int count, float dt );
+
+		void _remove( int index );
+		void _apply_pending_removals();
+
+		void _hash_state( SimulationChecksum& checksum ) const;
+
+	private:
+		//  Health given per unit of scale
+		const float HEALTH_PER_SCALE = 5.0f;
+		//  Radius of the collision sphere, scaled by the asteroid scale
+		const float COLLISION_RADIUS = 1.0f;
+
+		//  Asteroids integrated per job
+		static constexpr int INTEGRATE_CHUNK_SIZE = 256;
+
+	private:
+		std::vector<float> _location_x, _location_y, _location_z;
+		std::vector<float> _direction_x, _direction_y, _direction_z;
+		std::vector<float> _rotation_x, _rotation_y, _rotation_z, _rotation_w;
+		std::vector<float> _scale_x, _scale_y, _scale_z;
+
+		std::vector<float> _healths;
+		std::vector<int> _split_times;
+		std::vector<uint8> _model_ids;
+
+		//  Destroyed asteroids, removed at the next gathering of collision spheres
+		//  so indices given to the broadphase stay valid until its next build
+		std::vector<int> _pending_removals;
+
+		SharedPtr<AsteroidFieldRenderer> _renderer;
+	};
+}
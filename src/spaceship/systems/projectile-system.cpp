@@ -0,0 +1,176 @@
+#include "projectile-system.h"
+
+#include <spaceship/components/health-component.h>
+#include <spaceship/components/projectile-renderer.h>
+#include <spaceship/entities/spaceship.h>
+#include <spaceship/physics/collision-broadphase.h>
+#include <spaceship/utils/simulation-checksum.h>
+
+#include <suprengine/core/assets.h>
+
+using namespace spaceship;
+
+void ProjectileSystem::setup()
+{
+	_renderer = create_component<ProjectileRenderer>(
+		as<ProjectileSystem>(),
+		Assets::get_model( "projectile" )
+	);
+
+	_world->wk_projectile_system = as<ProjectileSystem>();
+
+	SimulationChecksum::track(
+		*_world,
+		as<Entity>(),
+		nullptr,
+		[this]( SimulationChecksum& checksum ) { _hash_state( checksum ); }
+	);
+}
+
+void ProjectileSystem::update_this( const float dt )
+{
+	// Lifetime
+	int index = 0;
+	while ( index < get_count() )
+	{
+		_life_times[index] -= dt;
+		if ( _life_times[index] <= 0.0f )
+		{
+			_remove( index );
+			continue;
+		}
+
+		index++;
+	}
+
+	const int count = get_count();
+	if ( count == 0 ) return;
+
+	// Check safe movements in a single batch
+	_queries.resize( count );
+	for ( int i = 0; i < count; i++ )
+	{
+		SegmentQuery& query = _queries[i];
+		query.ray = Ray( _locations[i], _directions[i], _move_speeds[i] * dt );
+		query.ignored_entity_id = _owner_ids[i];
+	}
+
+	if ( const SharedPtr<CollisionBroadphase> broadphase = _world->get_broadphase() )
+	{
+		broadphase->query_segments( _queries, _query_results );
+	}
+	else
+	{
+		_query_results.assign( count, SegmentQueryResult {} );
+	}
+
+	// Apply hits in projectiles order
+	for ( int i = 0; i < count; i++ )
+	{
+		if ( !_query_results[i].has_hit ) continue;
+
+		_on_hit( i, _query_results[i] );
+	}
+
+	// Movement, backward so removals only swap already processed projectiles
+	for ( int i = count - 1; i >= 0; i-- )
+	{
+		if ( _query_results[i].has_hit )
+		{
+			_remove( i );
+			continue;
+		}
+
+		_locations[i] += _queries[i].ray.direction * _queries[i].ray.distance;
+	}
+}
+
+void ProjectileSystem::spawn( const SharedPtr<Spaceship>& owner, const ProjectileSpawnInfo& info )
+{
+	_locations.push_back( info.location );
+	_directions.push_back( info.rotation.get_forward() );
+	_rotations.push_back( info.rotation );
+	_move_speeds.push_back( info.move_speed );
+	_life_times.push_back( LIFETIME );
+	_damage_amounts.push_back( info.damage_amount );
+	_knockback_forces.push_back( info.knockback_force );
+	_colors.push_back( info.color );
+	_owner_ids.push_back( owner->get_unique_id() );
+	_owners.push_back( owner );
+}
+
+void ProjectileSystem::clear()
+{
+	_locations.clear();
+	_directions.clear();
+	_rotations.clear();
+	_move_speeds.clear();
+	_life_times.clear();
+	_damage_amounts.clear();
+	_knockback_forces.clear();
+	_colors.clear();
+	_owner_ids.clear();
+	_owners.clear();
+}
+
+void ProjectileSystem::_remove( const int index )
+{
+	// Swap with the last projectile to keep arrays contiguous
+	const int last_index = get_count() - 1;
+	if ( index != last_index )
+	{
+		_locations[index] = _locations[last_index];
+		_directions[index] = _directions[last_index];
+		_rotations[index] = _rotations[last_index];
+		_move_speeds[index] = _move_speeds[last_index];
+		_life_times[index] = _life_times[last_index];
+		_damage_amounts[index] = _damage_amounts[last_index];
+		_knockback_forces[index] = _knockback_forces[last_index];
+		_colors[index] = _colors[last_index];
+		_owner_ids[index] = _owner_ids[last_index];
+		_owners[index] = std::move( _owners[last_index] );
+	}
+
+	_locations.pop_back();
+	_directions.pop_back();
+	_rotations.pop_back();
+	_move_speeds.pop_back();
+	_life_times.pop_back();
+	_damage_amounts.pop_back();
+	_knockback_forces.pop_back();
+	_colors.pop_back();
+	_owner_ids.pop_back();
+	_owners.pop_back();
+}
+
+void ProjectileSystem::_on_hit( const int index, const SegmentQueryResult& result )
+{
+	const SharedPtr<Spaceship> owner = _owners[index].lock();
+
+	// Damage health component or source body
+	DamageInfo info {};
+	info.attacker = owner;
+	info.damage = _damage_amounts[index];
+	info.knockback = -result.hit.normal * _knockback_forces[index];
+
+	const DamageResult damage_result = CollisionBroadphase::damage( result, info );
+
+	// Alert owner
+	if ( damage_result.is_valid && owner )
+	{
+		owner->on_hit.invoke( damage_result );
+	}
+}
+
+void ProjectileSystem::_hash_state( SimulationChecksum& checksum ) const
+{
+	const int count = get_count();
+	checksum.add( static_cast<uint32>( count ) );
+
+	for ( int i = 0; i < count; i++ )
+	{
+		checksum.add( _locations[i] );
+		checksum.add( _life_times[i] );
+		checksum.add( _owner_ids[i] );
+	}
+}
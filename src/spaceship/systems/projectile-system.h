@@ -0,0 +1,82 @@
+#pragma once
+
+#include <vector>
+
+#include <spaceship/physics/collision-broadphase.h>
+
+#include <suprengine/core/entity.h>
+#include <suprengine/utils/ray.h>
+
+namespace spaceship
+{
+	using namespace suprengine;
+
+	class Spaceship;
+	class ProjectileRenderer;
+	class SimulationChecksum;
+
+	struct ProjectileSpawnInfo
+	{
+		Vec3 location = Vec3::zero;
+		Quaternion rotation = Quaternion::identity;
+
+		Color color = Color::white;
+
+		float move_speed = 750.0f;
+		float damage_amount = 5.0f;
+		float knockback_force = 80.0f;
+	};
+
+	/*
+	 * Stores all live projectiles in contiguous arrays and advances them in a
+	 * single loop, instead of having one entity per bullet. Projectiles are drawn
+	 * in one pass by the attached ProjectileRenderer.
+	 */
+	class ProjectileSystem : public WorldEntity
+	{
+	public:
+		void setup() override;
+		void update_this( float dt ) override;
+
+		void spawn( const SharedPtr<Spaceship>& owner, const ProjectileSpawnInfo& info );
+		void clear();
+
+		int get_count() const { return static_cast<int>( _locations.size() ); }
+
+		const std::vector<Vec3>& get_locations() const { return _locations; }
+		const std::vector<Quaternion>& get_rotations() const { return _rotations; }
+		const std::vector<Color>& get_colors() const { return _colors; }
+
+	public:
+		//  Scale applied to all projectiles models
+		const float PROJECTILE_SCALE = 1.5f;
+		//  Time before a projectile disappears
+		const float LIFETIME = 3.0f;
+
+	private:
+		void _remove( int index );
+		void _on_hit( int index, const SegmentQueryResult& result );
+
+		void _hash_state( SimulationChecksum& checksum ) const;
+
+	private:
+		std::vector<Vec3> _locations;
+		std::vector<Vec3> _directions;
+		std::vector<Quaternion> _rotations;
+		std::vector<float> _move_speeds;
+		std::vector<float> _life_times;
+		std::vector<float> _damage_amounts;
+		std::vector<float> _knockback_forces;
+		std::vector<Color> _colors;
+
+		//  Owners unique IDs, compared to ignore hits on their own spaceship
+		std::vector<uint32> _owner_ids;
+		std::vector<WeakPtr<Spaceship>> _owners;
+
+		//  Per-frame buffers, kept to avoid re-allocations
+		std::vector<SegmentQuery> _queries;
+		std::vector<SegmentQueryResult> _query_results;
+
+		SharedPtr<ProjectileRenderer> _renderer;
+	};
+}
@@ -0,0 +1,204 @@
+#include "targeting-service.h"
+
+#include <spaceship/world.h>
+#include <spaceship/entities/ai-spaceship-controller.h>
+
+using namespace spaceship;
+
+void TargetingService::register_controller( const SharedPtr<AISpaceshipController>& controller )
+{
+	_controllers.push_back( controller );
+}
+
+void TargetingService::update( const World& world )
+{
+	_updates_count++;
+
+	std::erase_if( _controllers,
+		[]( const WeakPtr<AISpaceshipController>& wk_controller )
+		{
+			return wk_controller.expired();
+		}
+	);
+
+	// Count current assignments
+	_attackers_counts.clear();
+	_targets_ids.clear();
+	for ( const WeakPtr<AISpaceshipController>& wk_controller : _controllers )
+	{
+		const SharedPtr<AISpaceshipController> controller = wk_controller.lock();
+		const SharedPtr<Spaceship> ship = controller->get_ship();
+		const SharedPtr<Spaceship> target = controller->wk_target.lock();
+		if ( ship == nullptr || target == ship || !is_valid_target( target ) ) continue;
+
+		_attackers_counts[target->get_unique_id()]++;
+		_targets_ids[ship->get_unique_id()] = target->get_unique_id();
+	}
+
+	// Candidates of the fallback search, in creation order
+	_free_targets.clear();
+	for ( const WeakPtr<Spaceship>& wk_spaceship : world.spaceships )
+	{
+		const SharedPtr<Spaceship> spaceship = wk_spaceship.lock();
+		if ( !is_valid_target( spaceship ) || !_has_free_slot( spaceship->get_unique_id() ) ) continue;
+
+		_free_targets.push_back( spaceship );
+	}
+	_fallback_cursor = 0;
+
+	// Assign in creation order to keep the simulation deterministic
+	for ( size_t i = 0; i < _controllers.size(); i++ )
+	{
+		const SharedPtr<AISpaceshipController> controller = _controllers[i].lock();
+		const SharedPtr<Spaceship> ship = controller->get_ship();
+		if ( ship == nullptr || ship->state != EntityState::Active ) continue;
+
+		SharedPtr<Spaceship> target = controller->wk_target.lock();
+		const bool has_target = target != ship && is_valid_target( target );
+		const bool should_reevaluate = ( _updates_count + i ) % REEVALUATION_PERIOD == 0;
+		if ( has_target && !should_reevaluate ) continue;
+
+		// Free the current slot for the search to see the actual capacity
+		if ( has_target && _attackers_counts[target->get_unique_id()]-- == MAX_ATTACKERS_PER_TARGET )
+		{
+			_free_targets.push_back( target );
+		}
+
+		float best_score = 0.0f;
+		SharedPtr<Spaceship> best_target = _find_near_target( world, *ship, &best_score );
+		if ( has_target )
+		{
+			// Only switch for a clearly better target
+			const float current_score = _compute_score( *ship, *target );
+			if ( best_target == nullptr || best_score > current_score - SWITCH_SCORE_MARGIN )
+			{
+				best_target = target;
+			}
+		}
+		else if ( best_target == nullptr )
+		{
+			best_target = _find_any_target( *ship );
+		}
+
+		controller->wk_target = best_target;
+		if ( best_target != nullptr )
+		{
+			_attackers_counts[best_target->get_unique_id()]++;
+			_targets_ids[ship->get_unique_id()] = best_target->get_unique_id();
+		}
+		else
+		{
+			_targets_ids.erase( ship->get_unique_id() );
+		}
+	}
+}
+
+int TargetingService::get_attackers_count( const uint32 target_id ) const
+{
+	const auto itr = _attackers_counts.find( target_id );
+	if ( itr == _attackers_counts.end() ) return 0;
+
+	return itr->second;
+}
+
+bool TargetingService::is_valid_target( const SharedPtr<Spaceship>& target )
+{
+	return target != nullptr
+		&& target->state == EntityState::Active
+		&& target->get_health_component()->is_alive();
+}
+
+float TargetingService::_compute_score( const Spaceship& attacker, const Spaceship& candidate ) const
+{
+	float score = ( candidate.transform->location - attacker.transform->location ).length();
+
+	// Fight back against spaceships targeting the attacker
+	const auto itr = _targets_ids.find( candidate.get_unique_id() );
+	if ( itr != _targets_ids.end() && itr->second == attacker.get_unique_id() )
+	{
+		score -= THREAT_DISTANCE_BONUS;
+	}
+
+	return score;
+}
+
+bool TargetingService::_has_free_slot( const uint32 target_id ) const
+{
+	return get_attackers_count( target_id ) < MAX_ATTACKERS_PER_TARGET;
+}
+
+SharedPtr<Spaceship> TargetingService::_find_near_target(
+	const World& world,
+	const Spaceship& attacker,
+	float* out_score
+) const
+{
+	const uint32 attacker_id = attacker.get_unique_id();
+	const Vec3& location = attacker.transform->location;
+
+	SharedPtr<Spaceship> best_target = nullptr;
+	uint32 best_id = 0;
+	float best_score = 0.0f;
+
+	// Widen the search only when nothing is found nearby
+	for ( const float radius : SEARCH_RADIUSES )
+	{
+		const float radius_sqr = radius * radius;
+		world.spaceships_index.query_sphere( location, radius,
+			[&]( const SpatialGrid<World::SpaceshipIndexItem>::Entry& entry )
+			{
+				const uint32 unique_id = entry.item.unique_id;
+				if ( unique_id == attacker_id || !_has_free_slot( unique_id ) ) return;
+				if ( ( entry.location - location ).length_sqr() > radius_sqr ) return;
+
+				const SharedPtr<Spaceship> candidate = entry.item.wk_ship.lock();
+				if ( !is_valid_target( candidate ) ) return;
+
+				// Break ties on ids to not depend on the order of cells
+				const float score = _compute_score( attacker, *candidate );
+				if ( best_target != nullptr
+				  && ( score > best_score || ( score == best_score && unique_id > best_id ) ) ) return;
+
+				best_target = candidate;
+				best_id = unique_id;
+				best_score = score;
+			}
+		);
+
+		if ( best_target != nullptr ) break;
+	}
+
+	*out_score = best_score;
+	return best_target;
+}
+
+SharedPtr<Spaceship> TargetingService::_find_any_target( const Spaceship& attacker )
+{
+	// The attacker is only skipped as many times as it is in the list
+	size_t skipped_count = 0;
+	while ( skipped_count < _free_targets.size() )
+	{
+		_fallback_cursor %= _free_targets.size();
+
+		// Remove candidates which died or became full, the next one takes their place
+		const SharedPtr<Spaceship> candidate = _free_targets[_fallback_cursor].lock();
+		if ( !is_valid_target( candidate ) || !_has_free_slot( candidate->get_unique_id() ) )
+		{
+			_free_targets[_fallback_cursor] = _free_targets.back();
+			_free_targets.pop_back();
+			continue;
+		}
+
+		// Spread attackers over the free targets
+		_fallback_cursor++;
+		if ( candidate.get() == &attacker )
+		{
+			skipped_count++;
+			continue;
+		}
+
+		return candidate;
+	}
+
+	return nullptr;
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include <suprengine/utils/memory.h>
+
+namespace spaceship
+{
+	using namespace suprengine;
+
+	class AISpaceshipController;
+	class Spaceship;
+	class World;
+
+	/*
+	 * Assigns targets to AI controllers from the world's spaceships index.
+	 *
+	 * Controllers whose target died or disappeared are reassigned in the next
+	 * update, and the others are re-evaluated in round-robin. Candidates are
+	 * scored by distance, favoring spaceships targeting the attacker, and a
+	 * target accepts a limited number of attackers. Each assignment only visits
+	 * the cells around its attacker, falling back to the spaceships with free
+	 * slots when none is near. A controller never targets its own spaceship.
+	 */
+	class TargetingService
+	{
+	public:
+		void register_controller( const SharedPtr<AISpaceshipController>& controller );
+
+		/*
+		 * Must be called once per frame, after the spaceships index is built.
+		 */
+		void update( const World& world );
+
+		int get_attackers_count( uint32 target_id ) const;
+
+		static bool is_valid_target( const SharedPtr<Spaceship>& target );
+
+	public:
+		//  Maximum number of controllers targeting the same spaceship
+		static constexpr int MAX_ATTACKERS_PER_TARGET = 3;
+		//  Radiuses of the successive searches around an attacker
+		static constexpr float SEARCH_RADIUSES[] { 256.0f, 640.0f };
+		//  Distance removed from the score of a candidate targeting the attacker
+		static constexpr float THREAT_DISTANCE_BONUS = 400.0f;
+		//  Score improvement required to switch from a valid target
+		static constexpr float SWITCH_SCORE_MARGIN = 150.0f;
+		//  Number of updates between two re-evaluations of a valid target
+		static constexpr int REEVALUATION_PERIOD = 30;
+
+	private:
+		float _compute_score( const Spaceship& attacker, const Spaceship& candidate ) const;
+		bool _has_free_slot( uint32 target_id ) const;
+
+		SharedPtr<Spaceship> _find_near_target( const World& world, const Spaceship& attacker, float* out_score ) const;
+		SharedPtr<Spaceship> _find_any_target( const Spaceship& attacker );
+
+	private:
+		uint64 _updates_count = 0;
+
+		//  Registered controllers, in creation order
+		std::vector<WeakPtr<AISpaceshipController>> _controllers;
+
+		//  Spaceships unique ids to the number of controllers targeting them
+		std::unordered_map<uint32, int> _attackers_counts;
+		//  Spaceships unique ids to the unique id of their controller's target
+		std::unordered_map<uint32, uint32> _targets_ids;
+
+		//  Spaceships which had a free slot when added, full or dead ones are removed when met
+		std::vector<WeakPtr<Spaceship>> _free_targets;
+		//  Index in the free targets the fallback search resumes from
+		size_t _fallback_cursor = 0;
+	};
+}
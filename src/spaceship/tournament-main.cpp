@@ -0,0 +1,26 @@
+#include <string_view>
+
+#include "headless-runner.h"
+#include "launch-settings.h"
+#include "tournament-runner.h"
+#include "tournament-settings.h"
+
+using namespace suprengine;
+
+int main( int arg_count, char** args )
+{
+	// Matches are simulated by launching this executable in headless mode
+	for ( int i = 1; i < arg_count; i++ )
+	{
+		if ( std::string_view( args[i] ) != "--headless" ) continue;
+
+		spaceship::HeadlessRunner runner( spaceship::GameLaunchSettings::from_arguments( arg_count, args ) );
+		return runner.run();
+	}
+
+	const spaceship::TournamentSettings settings =
+		spaceship::TournamentSettings::from_arguments( arg_count, args );
+
+	spaceship::TournamentRunner runner( settings, args[0] );
+	return runner.run();
+}
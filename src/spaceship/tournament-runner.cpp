@@ -0,0 +1,168 @@
+#include "tournament-runner.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+#include <spaceship/utils/match-stats.h>
+#include <spaceship/utils/worker-pool.h>
+
+#include <suprengine/utils/logger.h>
+
+using namespace spaceship;
+
+namespace fs = std::filesystem;
+
+static fs::path get_match_path( const fs::path& parts_path, const uint32 seed, const char* extension )
+{
+	return parts_path / ( std::to_string( seed ) + extension );
+}
+
+TournamentRunner::TournamentRunner( const TournamentSettings& settings, std::string executable_path )
+	: _settings( settings ), _executable_path( std::move( executable_path ) )
+{}
+
+int TournamentRunner::run()
+{
+	using clock = std::chrono::steady_clock;
+
+	const int matches_count = std::max( 0, _settings.matches_count );
+	const int workers_count = _settings.workers_count > 0
+		? _settings.workers_count
+		: std::max( 1, static_cast<int>( std::thread::hardware_concurrency() ) );
+
+	// Each match writes its own stats and logs, merged in seeds order once all are done
+	const fs::path parts_path = fs::path( _settings.output_path ).concat( ".parts" );
+	std::error_code error;
+	fs::create_directories( parts_path, error );
+	if ( error )
+	{
+		Logger::error( "Failed to create matches folder '%s'.", parts_path.string().c_str() );
+		return 1;
+	}
+
+	Logger::info(
+		"Running %d matches of %d ticks with %d AIs on %d workers.",
+		matches_count,
+		_settings.match_ticks,
+		_settings.ships_count,
+		workers_count
+	);
+
+	// Written by index from the workers, read once they are joined
+	std::vector<int> exit_codes( matches_count, 0 );
+
+	const clock::time_point start_time = clock::now();
+	{
+		WorkerPool workers( workers_count );
+		for ( int i = 0; i < matches_count; i++ )
+		{
+			const uint32 seed = _settings.first_seed + static_cast<uint32>( i );
+			const std::string command = _build_match_command(
+				seed,
+				get_match_path( parts_path, seed, ".csv" ).string(),
+				get_match_path( parts_path, seed, ".log" ).string()
+			);
+
+			workers.submit(
+				[command, i, &exit_codes]
+				{
+					exit_codes[i] = std::system( command.c_str() );
+				}
+			);
+		}
+		// Remaining matches are finished before the workers are joined
+	}
+	const clock::time_point end_time = clock::now();
+
+	int failed_count = 0;
+	for ( int i = 0; i < matches_count; i++ )
+	{
+		if ( exit_codes[i] == 0 ) continue;
+
+		const uint32 seed = _settings.first_seed + static_cast<uint32>( i );
+		Logger::error(
+			"Match with seed %u failed with code %d, see '%s'.",
+			seed,
+			exit_codes[i],
+			get_match_path( parts_path, seed, ".log" ).string().c_str()
+		);
+		failed_count++;
+	}
+
+	if ( !_merge_stats( parts_path.string() ) ) return 1;
+
+	// Keep logs of failed matches around
+	if ( failed_count == 0 )
+	{
+		fs::remove_all( parts_path, error );
+	}
+
+	// Report
+	const double seconds = std::chrono::duration<double>( end_time - start_time ).count();
+	Logger::info(
+		"Simulated %d matches in %.3fs: %.1f matches/min, %d failed. Stats written to '%s'.",
+		matches_count,
+		seconds,
+		seconds > 0.0 ? matches_count * 60.0 / seconds : 0.0,
+		failed_count,
+		_settings.output_path.c_str()
+	);
+
+	return failed_count == 0 ? 0 : 1;
+}
+
+std::string TournamentRunner::_build_match_command(
+	const uint32 seed,
+	const std::string& stats_path,
+	const std::string& log_path
+) const
+{
+	// Matches run in parallel already, their updates don't need more threads
+	std::string command = "\"" + _executable_path + "\" --headless --job-threads 0";
+	command += " --seed " + std::to_string( seed );
+	command += " --ai-count " + std::to_string( _settings.ships_count );
+	command += " --asteroids " + std::to_string( _settings.asteroid_count );
+	command += " --ticks " + std::to_string( _settings.match_ticks );
+	command += " --stats-file \"" + stats_path + "\"";
+	command += " > \"" + log_path + "\" 2>&1";
+
+#ifdef _WIN32
+	// cmd.exe strips the outer quotes of a command starting with a quote
+	command = "\"" + command + "\"";
+#endif
+
+	return command;
+}
+
+bool TournamentRunner::_merge_stats( const std::string& parts_path ) const
+{
+	std::ofstream output( _settings.output_path );
+	if ( !output.is_open() )
+	{
+		Logger::error( "Failed to open output file '%s'.", _settings.output_path.c_str() );
+		return false;
+	}
+
+	MatchStatsRecorder::write_header( output );
+
+	for ( int i = 0; i < _settings.matches_count; i++ )
+	{
+		const uint32 seed = _settings.first_seed + static_cast<uint32>( i );
+		std::ifstream part( get_match_path( parts_path, seed, ".csv" ) );
+		if ( !part.is_open() ) continue;
+
+		// Skip the header of each match
+		std::string line;
+		std::getline( part, line );
+		while ( std::getline( part, line ) )
+		{
+			output << line << '\n';
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <string>
+
+#include "tournament-settings.h"
+
+namespace spaceship
+{
+	/*
+	 * Simulates many headless matches between AI spaceships and gathers their
+	 * stats into a single CSV file.
+	 *
+	 * Worlds don't share gameplay state, but their entities still register
+	 * components and take unique ids from the engine singleton, so each match
+	 * runs in its own process: the runner launches its executable in headless
+	 * mode once per seed, keeping as many matches in flight as there are
+	 * workers. Matches update serially inside their process, so throughput
+	 * scales with cores without threads competing for them.
+	 */
+	class TournamentRunner
+	{
+	public:
+		TournamentRunner( const TournamentSettings& settings, std::string executable_path );
+
+		int run();
+
+	private:
+		std::string _build_match_command( uint32 seed, const std::string& stats_path, const std::string& log_path ) const;
+		bool _merge_stats( const std::string& parts_path ) const;
+
+	private:
+		TournamentSettings _settings;
+		std::string _executable_path;
+	};
+}
@@ -0,0 +1,55 @@
+#include "tournament-settings.h"
+
+#include <cstdlib>
+#include <string_view>
+
+#include <suprengine/utils/logger.h>
+
+using namespace spaceship;
+
+TournamentSettings TournamentSettings::from_arguments( const int arg_count, char** args )
+{
+	TournamentSettings settings {};
+
+	// Skip the executable path
+	for ( int i = 1; i < arg_count; i++ )
+	{
+		const std::string_view arg = args[i];
+		const bool has_value = i + 1 < arg_count;
+
+		if ( arg == "--matches" && has_value )
+		{
+			settings.matches_count = std::atoi( args[++i] );
+		}
+		else if ( arg == "--first-seed" && has_value )
+		{
+			settings.first_seed = static_cast<uint32>( std::strtoul( args[++i], nullptr, 10 ) );
+		}
+		else if ( arg == "--ships" && has_value )
+		{
+			settings.ships_count = std::atoi( args[++i] );
+		}
+		else if ( arg == "--asteroids" && has_value )
+		{
+			settings.asteroid_count = std::atoi( args[++i] );
+		}
+		else if ( arg == "--ticks" && has_value )
+		{
+			settings.match_ticks = std::atoi( args[++i] );
+		}
+		else if ( arg == "--workers" && has_value )
+		{
+			settings.workers_count = std::atoi( args[++i] );
+		}
+		else if ( arg == "--output" && has_value )
+		{
+			settings.output_path = args[++i];
+		}
+		else
+		{
+			Logger::warning( "Unknown command line argument '%s', ignoring it.", args[i] );
+		}
+	}
+
+	return settings;
+}
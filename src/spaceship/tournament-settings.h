@@ -0,0 +1,40 @@
+#pragma once
+
+#include <string>
+
+#include <suprengine/utils/memory.h>
+
+namespace spaceship
+{
+	using namespace suprengine;
+
+	/*
+	 * Scenario of a bot tournament, parsed from the command line.
+	 *
+	 * Supported arguments:
+	 * --matches <count>       Number of matches, one per seed starting from the first seed.
+	 * --first-seed <seed>     Seed of the first match.
+	 * --ships <count>         Number of AI spaceships per match.
+	 * --asteroids <count>     Number of asteroids per match.
+	 * --ticks <count>         Length of a match in ticks.
+	 * --workers <count>       Number of matches simulated at once, one per core if unspecified.
+	 * --output <path>         CSV file receiving the stats of all matches.
+	 */
+	struct TournamentSettings
+	{
+		int matches_count = 64;
+		uint32 first_seed = 0;
+
+		int ships_count = 20;
+		int asteroid_count = 32;
+		//  One minute at 60 ticks per second
+		int match_ticks = 3600;
+
+		//  When zero or negative, one worker per core is used
+		int workers_count = 0;
+
+		std::string output_path = "tournament.csv";
+
+		static TournamentSettings from_arguments( int arg_count, char** args );
+	};
+}
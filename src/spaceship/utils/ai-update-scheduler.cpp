@@ -0,0 +1,84 @@
+#include "ai-update-scheduler.h"
+
+#include <algorithm>
+#include <limits>
+
+#include <suprengine/math/math.h>
+
+using namespace spaceship;
+
+void AIUpdateScheduler::schedule( const std::vector<AIPlanCandidate>& candidates, std::vector<uint8>& should_plan )
+{
+	_tick++;
+
+	const int count = static_cast<int>( candidates.size() );
+	should_plan.assign( count, 0 );
+
+	// Sort candidates into tiers
+	for ( std::vector<int>& indices : _tier_indices )
+	{
+		indices.clear();
+	}
+	for ( int i = 0; i < count; i++ )
+	{
+		int tier = 0;
+		while ( tier < TIERS_COUNT - 1 && candidates[i].viewer_distance_sqr >= TIER_DISTANCES_SQR[tier] )
+		{
+			tier++;
+		}
+
+		_tier_indices[tier].push_back( i );
+	}
+
+	// Unlimited until the cost of a plan has been measured
+	int remaining_plans = std::numeric_limits<int>::max();
+	if ( budget_us > 0.0f && _plan_cost_us > 0.0f )
+	{
+		remaining_plans = static_cast<int>( budget_us / _plan_cost_us );
+	}
+
+	for ( int tier = 0; tier < TIERS_COUNT; tier++ )
+	{
+		std::vector<int>& indices = _tier_indices[tier];
+		const int tier_count = static_cast<int>( indices.size() );
+		const int period = TIER_PERIODS[tier];
+
+		// Renew enough plans for all of them to be within the period, the
+		// nearest tier is always fully planned whatever the budget
+		int plans_count = ( tier_count + period - 1 ) / period;
+		if ( tier > 0 )
+		{
+			plans_count = math::min( plans_count, math::max( 0, remaining_plans ) );
+		}
+		remaining_plans -= plans_count;
+
+		// Renew the oldest plans first
+		if ( plans_count < tier_count )
+		{
+			std::partial_sort( indices.begin(), indices.begin() + plans_count, indices.end(),
+				[&candidates]( const int lhs, const int rhs )
+				{
+					const AIPlanCandidate& a = candidates[lhs];
+					const AIPlanCandidate& b = candidates[rhs];
+					if ( a.last_plan_tick != b.last_plan_tick ) return a.last_plan_tick < b.last_plan_tick;
+					return a.unique_id < b.unique_id;
+				}
+			);
+		}
+
+		for ( int i = 0; i < plans_count; i++ )
+		{
+			should_plan[indices[i]] = 1;
+		}
+	}
+}
+
+void AIUpdateScheduler::report_duration( const float microseconds, const int plans_count )
+{
+	if ( plans_count <= 0 ) return;
+
+	const float plan_cost = microseconds / static_cast<float>( plans_count );
+	_plan_cost_us = _plan_cost_us > 0.0f
+		? math::lerp( _plan_cost_us, plan_cost, COST_SMOOTHING )
+		: plan_cost;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <vector>
+
+#include <suprengine/utils/memory.h>
+
+namespace spaceship
+{
+	using namespace suprengine;
+
+	struct AIPlanCandidate
+	{
+		//  Squared distance to the nearest viewer
+		float viewer_distance_sqr = 0.0f;
+		//  Tick of the last planning, the oldest plans are renewed first
+		uint64 last_plan_tick = 0;
+		uint32 unique_id = 0;
+	};
+
+	/*
+	 * Selects which AI controllers re-plan their inputs in a frame, the others
+	 * reuse their last inputs.
+	 *
+	 * Candidates are sorted into tiers by their distance to the nearest viewer.
+	 * The nearest tier re-plans every frame, farther tiers are renewed in
+	 * round-robin: each frame, the oldest plans of a tier are renewed so that
+	 * all of them are within the tier's period.
+	 *
+	 * Without budget, the selection only depends on ticks and distances and is
+	 * deterministic. With a budget, farther tiers are cut short once the
+	 * measured cost of the planned candidates would exceed it, which makes
+	 * the selection depend on timings.
+	 */
+	class AIUpdateScheduler
+	{
+	public:
+		/*
+		 * Writes whether each candidate should re-plan this frame, and advances
+		 * to the next tick.
+		 */
+		void schedule( const std::vector<AIPlanCandidate>& candidates, std::vector<uint8>& should_plan );
+		/*
+		 * Feeds the measured duration of the planning phase, used to estimate
+		 * how many candidates fit into the budget.
+		 */
+		void report_duration( float microseconds, int plans_count );
+
+		uint64 get_tick() const { return _tick; }
+
+	public:
+		//  Maximum duration of the planning phase, in microseconds, zero for unlimited
+		float budget_us = 0.0f;
+
+	public:
+		static constexpr int TIERS_COUNT = 4;
+		//  Squared distances from which a candidate belongs to the next tier
+		static constexpr float TIER_DISTANCES_SQR[TIERS_COUNT - 1] {
+			400.0f * 400.0f,
+			1000.0f * 1000.0f,
+			2000.0f * 2000.0f,
+		};
+		//  Number of ticks between two plans of a tier's candidates
+		static constexpr int TIER_PERIODS[TIERS_COUNT] { 1, 2, 4, 8 };
+		//  Smoothing of the measured cost of a plan
+		static constexpr float COST_SMOOTHING = 0.1f;
+
+	private:
+		uint64 _tick = 0;
+		//  Estimated cost of a plan in microseconds, unknown until measured
+		float _plan_cost_us = 0.0f;
+
+		std::vector<int> _tier_indices[TIERS_COUNT];
+	};
+}
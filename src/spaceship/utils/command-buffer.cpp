@@ -0,0 +1,53 @@
+#include "command-buffer.h"
+
+using namespace spaceship;
+
+thread_local CommandBuffer* CommandBuffer::_current = nullptr;
+
+CommandBuffer::Scope::Scope( CommandBuffer& buffer )
+	: _previous_buffer( _current )
+{
+	_current = &buffer;
+}
+
+CommandBuffer::Scope::~Scope()
+{
+	_current = _previous_buffer;
+}
+
+void CommandBuffer::push( Command command )
+{
+	_commands.push_back( std::move( command ) );
+}
+
+void CommandBuffer::execute()
+{
+	// Commands may record new commands, which are kept for the next execution
+	_executing_commands.swap( _commands );
+
+	for ( Command& command : _executing_commands )
+	{
+		command();
+	}
+
+	_executing_commands.clear();
+}
+
+void CommandBuffer::defer( Command command )
+{
+	if ( _current != nullptr )
+	{
+		_current->push( std::move( command ) );
+		return;
+	}
+
+	command();
+}
+
+void CommandBuffer::execute_all( std::vector<CommandBuffer>& buffers )
+{
+	for ( CommandBuffer& buffer : buffers )
+	{
+		buffer.execute();
+	}
+}
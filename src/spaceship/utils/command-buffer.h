@@ -0,0 +1,70 @@
+#pragma once
+
+#include <vector>
+
+#include <spaceship/utils/inplace-function.hpp>
+
+namespace spaceship
+{
+	/*
+	 * Records effects on other entities, e.g. damages, spawns or kills, from a
+	 * job to apply them later on the main thread, in recording order.
+	 *
+	 * Code running in a job records into the buffer bound to its thread through
+	 * 'defer', which runs the command immediately when no buffer is bound, so the
+	 * same code works both serially and in jobs.
+	 */
+	class CommandBuffer
+	{
+	public:
+		//  Stored inline so recording doesn't allocate once the buffer has grown
+		using Command = InplaceFunction<void(), 64>;
+
+		/*
+		 * Binds the buffer to the current thread for its lifetime.
+		 */
+		class Scope
+		{
+		public:
+			explicit Scope( CommandBuffer& buffer );
+			~Scope();
+
+			Scope( const Scope& ) = delete;
+			Scope& operator=( const Scope& ) = delete;
+
+		private:
+			CommandBuffer* _previous_buffer = nullptr;
+		};
+
+	public:
+		void push( Command command );
+		/*
+		 * Runs all commands in recording order, then clears them.
+		 */
+		void execute();
+		void clear() { _commands.clear(); }
+
+		bool is_empty() const { return _commands.empty(); }
+		int get_count() const { return static_cast<int>( _commands.size() ); }
+
+		/*
+		 * Records the command in the buffer bound to the current thread, or runs
+		 * it immediately if there is none.
+		 */
+		static void defer( Command command );
+		static CommandBuffer* get_current() { return _current; }
+
+		/*
+		 * Executes buffers in the given order, used at sync points with one buffer
+		 * per chunk so the order doesn't depend on threads scheduling.
+		 */
+		static void execute_all( std::vector<CommandBuffer>& buffers );
+
+	private:
+		std::vector<Command> _commands;
+		//  Commands being executed, swapped with the recorded ones to keep both capacities
+		std::vector<Command> _executing_commands;
+
+		static thread_local CommandBuffer* _current;
+	};
+}
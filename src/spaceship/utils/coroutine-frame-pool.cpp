@@ -0,0 +1,66 @@
+#include "coroutine-frame-pool.h"
+
+#include <new>
+
+using namespace spaceship;
+
+void* CoroutineFramePool::allocate( const size_t size )
+{
+	// Find the smallest block fitting the frame and its header
+	const size_t total_size = size + HEADER_SIZE;
+	int size_class = 0;
+	while ( size_class < SIZE_CLASSES_COUNT && ( MIN_BLOCK_SIZE << size_class ) < total_size )
+	{
+		size_class++;
+	}
+	if ( size_class == SIZE_CLASSES_COUNT ) return allocate_unpooled( size );
+
+	if ( _free_blocks[size_class] == nullptr )
+	{
+		_allocate_page( size_class );
+	}
+
+	FreeBlock* block = _free_blocks[size_class];
+	_free_blocks[size_class] = block->next;
+
+	Header* header = new ( block ) Header { this, size_class };
+	return reinterpret_cast<std::byte*>( header ) + HEADER_SIZE;
+}
+
+void* CoroutineFramePool::allocate_unpooled( const size_t size )
+{
+	void* memory = ::operator new( size + HEADER_SIZE );
+
+	Header* header = new ( memory ) Header { nullptr, -1 };
+	return reinterpret_cast<std::byte*>( header ) + HEADER_SIZE;
+}
+
+void CoroutineFramePool::deallocate( void* pointer )
+{
+	Header* header = reinterpret_cast<Header*>( static_cast<std::byte*>( pointer ) - HEADER_SIZE );
+
+	CoroutineFramePool* pool = header->pool;
+	if ( pool == nullptr )
+	{
+		::operator delete( header );
+		return;
+	}
+
+	const int size_class = header->size_class;
+	FreeBlock* block = new ( header ) FreeBlock { pool->_free_blocks[size_class] };
+	pool->_free_blocks[size_class] = block;
+}
+
+void CoroutineFramePool::_allocate_page( const int size_class )
+{
+	const size_t block_size = MIN_BLOCK_SIZE << size_class;
+
+	std::unique_ptr<std::byte[]> page = std::make_unique<std::byte[]>( block_size * BLOCKS_PER_PAGE );
+	for ( int i = BLOCKS_PER_PAGE - 1; i >= 0; i-- )
+	{
+		FreeBlock* block = new ( page.get() + block_size * i ) FreeBlock { _free_blocks[size_class] };
+		_free_blocks[size_class] = block;
+	}
+
+	_pages.push_back( std::move( page ) );
+}
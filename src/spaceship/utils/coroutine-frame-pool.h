@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace spaceship
+{
+	/*
+	 * Recycles coroutine frames in blocks of power-of-two sizes, allocated by
+	 * pages and never released until the pool is destroyed. Frames larger than
+	 * the biggest block fall back to the heap.
+	 *
+	 * Each block starts with a header referencing its pool, so frames can be
+	 * released without knowing where they come from. Not thread-safe, frames
+	 * must be created and destroyed on the thread owning the pool.
+	 */
+	class CoroutineFramePool
+	{
+	public:
+		CoroutineFramePool() = default;
+
+		CoroutineFramePool( const CoroutineFramePool& ) = delete;
+		CoroutineFramePool& operator=( const CoroutineFramePool& ) = delete;
+
+		void* allocate( size_t size );
+
+		/*
+		 * Allocates a frame on the heap, releasable through 'deallocate'.
+		 */
+		static void* allocate_unpooled( size_t size );
+		static void deallocate( void* pointer );
+
+		int get_pages_count() const { return static_cast<int>( _pages.size() ); }
+
+	public:
+		//  Size of the smallest block, header included
+		static constexpr size_t MIN_BLOCK_SIZE = 128;
+		//  Number of block sizes, doubling each time
+		static constexpr int SIZE_CLASSES_COUNT = 6;
+		//  Blocks allocated at once when a size runs out of free blocks
+		static constexpr int BLOCKS_PER_PAGE = 16;
+		//  Keeps frames aligned as if they were allocated by 'operator new'
+		static constexpr size_t HEADER_SIZE = alignof( std::max_align_t );
+
+	private:
+		struct Header
+		{
+			CoroutineFramePool* pool;
+			int size_class;
+		};
+		static_assert( sizeof( Header ) <= HEADER_SIZE );
+
+		struct FreeBlock
+		{
+			FreeBlock* next;
+		};
+
+	private:
+		void _allocate_page( int size_class );
+
+	private:
+		FreeBlock* _free_blocks[SIZE_CLASSES_COUNT] {};
+		std::vector<std::unique_ptr<std::byte[]>> _pages;
+	};
+}
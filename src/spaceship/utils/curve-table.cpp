@@ -0,0 +1,38 @@
+#include "curve-table.h"
+
+#include <suprengine/math/math.h>
+
+using namespace spaceship;
+
+CurveTable::CurveTable( const std::vector<SharedPtr<Curve>>& curves, const int resolution )
+	: _channels_count( static_cast<int>( curves.size() ) ),
+	  _resolution( math::max( MIN_RESOLUTION, resolution ) )
+{
+	_samples.resize( static_cast<size_t>( _resolution ) * _channels_count );
+
+	const float step = 1.0f / static_cast<float>( _resolution - 1 );
+	for ( int i = 0; i < _resolution; i++ )
+	{
+		const float t = static_cast<float>( i ) * step;
+
+		for ( int channel = 0; channel < _channels_count; channel++ )
+		{
+			const SharedPtr<Curve>& curve = curves[channel];
+			_samples[i * _channels_count + channel] = curve ? curve->evaluate_by_time( t ) : 0.0f;
+		}
+	}
+}
+
+void CurveTable::evaluate( const float t, float* out_values ) const
+{
+	const float position = math::clamp( t, 0.0f, 1.0f ) * static_cast<float>( _resolution - 1 );
+	const int index = math::min( static_cast<int>( position ), _resolution - 2 );
+	const float alpha = position - static_cast<float>( index );
+
+	const float* from = &_samples[index * _channels_count];
+	const float* to = from + _channels_count;
+	for ( int channel = 0; channel < _channels_count; channel++ )
+	{
+		out_values[channel] = math::lerp( from[channel], to[channel], alpha );
+	}
+}
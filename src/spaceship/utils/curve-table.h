@@ -0,0 +1,41 @@
+#pragma once
+
+#include <vector>
+
+#include <suprengine/utils/curve.h>
+#include <suprengine/utils/memory.h>
+
+namespace spaceship
+{
+	using namespace suprengine;
+
+	/*
+	 * Curves sampled at a fixed resolution over [0; 1], stored interleaved so all
+	 * channels are fetched together. Evaluation linearly interpolates between the
+	 * two nearest samples instead of evaluating the curves keys.
+	 */
+	class CurveTable
+	{
+	public:
+		CurveTable( const std::vector<SharedPtr<Curve>>& curves, int resolution );
+
+		/*
+		 * Writes the value of each channel at the given time, clamped to [0; 1],
+		 * in the output array, which must hold as many floats as channels.
+		 */
+		void evaluate( float t, float* out_values ) const;
+
+		int get_channels_count() const { return _channels_count; }
+		int get_resolution() const { return _resolution; }
+
+	public:
+		static constexpr int MIN_RESOLUTION = 2;
+
+	private:
+		int _channels_count = 0;
+		int _resolution = 0;
+
+		//  Samples of all channels, per time
+		std::vector<float> _samples;
+	};
+}
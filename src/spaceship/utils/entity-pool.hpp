@@ -0,0 +1,102 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include <spaceship/world.h>
+
+namespace spaceship
+{
+	using namespace suprengine;
+
+	/*
+	 * Recycles short-lived entities instead of creating and killing them.
+	 *
+	 * Entities are only created through the world owning the pool when no released entity is
+	 * available, so their components and cached assets are set up once. Released
+	 * and prewarmed entities are paused, hidden, and wait in the pool until acquired.
+	 *
+	 * The pooled type must be default-constructible and implement a 'reset'
+	 * function, called with the arguments given to 'acquire', to re-initialize
+	 * its state, and a 'hide' function to deactivate its renderers, since paused
+	 * entities are still rendered.
+	 */
+	template <typename T>
+	class EntityPool
+	{
+	public:
+		explicit EntityPool( World& world )
+			: _world( world )
+		{}
+
+		/*
+		 * Creates entities until the given count is available in the pool.
+		 */
+		void prewarm( const int count )
+		{
+			_free_entities.reserve( count );
+			while ( static_cast<int>( _free_entities.size() ) < count )
+			{
+				const SharedPtr<T> entity = _world.create_entity<T>();
+				entity->state = EntityState::Paused;
+				entity->hide();
+				_free_entities.push_back( entity );
+				_created_count++;
+			}
+		}
+
+		template <typename ...Args>
+		SharedPtr<T> acquire( Args&& ...args )
+		{
+			SharedPtr<T> entity = nullptr;
+
+			// Entities killed by the engine, e.g. on scene change, can't be re-used
+			while ( !_free_entities.empty() && entity == nullptr )
+			{
+				entity = std::move( _free_entities.back() );
+				_free_entities.pop_back();
+
+				if ( entity->state == EntityState::Dead )
+				{
+					entity = nullptr;
+				}
+			}
+
+			if ( entity == nullptr )
+			{
+				entity = _world.create_entity<T>();
+				_created_count++;
+			}
+
+			entity->state = EntityState::Active;
+			entity->reset( std::forward<Args>( args )... );
+			return entity;
+		}
+
+		void release( const SharedPtr<T>& entity )
+		{
+			// Avoid releasing twice in the same tick
+			if ( entity->state != EntityState::Active ) return;
+
+			entity->state = EntityState::Paused;
+			entity->hide();
+			_free_entities.push_back( entity );
+		}
+
+		void clear()
+		{
+			_free_entities.clear();
+			_created_count = 0;
+		}
+
+		int get_free_count() const { return static_cast<int>( _free_entities.size() ); }
+		//  Number of entities created by the pool since the last clear
+		int get_created_count() const { return _created_count; }
+
+	private:
+		World& _world;
+
+		std::vector<SharedPtr<T>> _free_entities;
+		int _created_count = 0;
+	};
+}
@@ -0,0 +1,29 @@
+#include "fixed-timestep.h"
+
+#include <suprengine/math/math.h>
+
+using namespace spaceship;
+
+FixedTimestep::FixedTimestep( const float step_time, const int max_steps_per_frame )
+	: _step_time( step_time ),
+	  _max_accumulated_time( step_time * static_cast<float>( max_steps_per_frame ) )
+{}
+
+void FixedTimestep::accumulate( const float frame_time )
+{
+	_accumulated_time = math::min( _accumulated_time + frame_time, _max_accumulated_time );
+}
+
+bool FixedTimestep::consume_step()
+{
+	if ( _accumulated_time < _step_time ) return false;
+
+	_accumulated_time -= _step_time;
+	_tick_count++;
+	return true;
+}
+
+float FixedTimestep::get_interpolation_alpha() const
+{
+	return _accumulated_time / _step_time;
+}
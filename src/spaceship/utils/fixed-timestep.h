@@ -0,0 +1,46 @@
+#pragma once
+
+#include <suprengine/utils/memory.h>
+
+namespace spaceship
+{
+	using namespace suprengine;
+
+	/*
+	 * Accumulates variable frame times and splits them into steps of a fixed
+	 * duration, so the simulation advances identically whatever the frame rate.
+	 *
+	 * Usage:
+	 * timestep.accumulate( frame_time );
+	 * while ( timestep.consume_step() )
+	 * {
+	 *     update( timestep.get_step_time() );
+	 * }
+	 */
+	class FixedTimestep
+	{
+	public:
+		explicit FixedTimestep( float step_time, int max_steps_per_frame = 8 );
+
+		void accumulate( float frame_time );
+		bool consume_step();
+
+		float get_step_time() const { return _step_time; }
+		uint64 get_tick_count() const { return _tick_count; }
+
+		/*
+		 * Returns the ratio of the next step already accumulated, between 0.0 and 1.0.
+		 * Useful to interpolate visuals between the last two simulated states.
+		 */
+		float get_interpolation_alpha() const;
+
+	private:
+		float _step_time;
+		//  Upper bound of accumulated time, prevents the simulation from
+		//  spiraling down when a frame takes longer than the steps it generates
+		float _max_accumulated_time;
+
+		float _accumulated_time = 0.0f;
+		uint64 _tick_count = 0;
+	};
+}
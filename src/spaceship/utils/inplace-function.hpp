@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace spaceship
+{
+	template <typename Signature, size_t Capacity = 64>
+	class InplaceFunction;
+
+	/*
+	 * Move-only callable stored inside a fixed buffer instead of the heap.
+	 * Callables larger than the capacity are rejected at compile time, capture
+	 * weak or shared pointers rather than big values.
+	 */
+	template <typename R, typename ...Args, size_t Capacity>
+	class InplaceFunction<R( Args... ), Capacity>
+	{
+	public:
+		InplaceFunction() = default;
+
+		template <typename F>
+			requires ( !std::is_same_v<std::decay_t<F>, InplaceFunction> )
+		InplaceFunction( F&& callable )
+		{
+			using T = std::decay_t<F>;
+			static_assert( sizeof( T ) <= Capacity, "Callable doesn't fit into the InplaceFunction capacity." );
+			static_assert( alignof( T ) <= alignof( std::max_align_t ), "Callable is over-aligned for InplaceFunction." );
+			static_assert( std::is_nothrow_move_constructible_v<T>, "Callable must be nothrow move-constructible." );
+
+			new ( _storage ) T( std::forward<F>( callable ) );
+			_operations = &OPERATIONS<T>;
+		}
+
+		InplaceFunction( InplaceFunction&& other ) noexcept
+		{
+			_move_from( other );
+		}
+		InplaceFunction& operator=( InplaceFunction&& other ) noexcept
+		{
+			if ( this != &other )
+			{
+				reset();
+				_move_from( other );
+			}
+			return *this;
+		}
+
+		InplaceFunction( const InplaceFunction& ) = delete;
+		InplaceFunction& operator=( const InplaceFunction& ) = delete;
+
+		~InplaceFunction()
+		{
+			reset();
+		}
+
+		R operator()( Args... args )
+		{
+			return _operations->invoke( _storage, std::forward<Args>( args )... );
+		}
+
+		void reset()
+		{
+			if ( _operations == nullptr ) return;
+
+			_operations->destroy( _storage );
+			_operations = nullptr;
+		}
+
+		explicit operator bool() const { return _operations != nullptr; }
+
+	private:
+		struct Operations
+		{
+			R ( *invoke )( void* storage, Args&&... args );
+			void ( *move )( void* destination, void* source );
+			void ( *destroy )( void* storage );
+		};
+
+		template <typename T>
+		static constexpr Operations OPERATIONS {
+			[]( void* storage, Args&&... args ) -> R
+			{
+				return ( *static_cast<T*>( storage ) )( std::forward<Args>( args )... );
+			},
+			[]( void* destination, void* source )
+			{
+				new ( destination ) T( std::move( *static_cast<T*>( source ) ) );
+				static_cast<T*>( source )->~T();
+			},
+			[]( void* storage )
+			{
+				static_cast<T*>( storage )->~T();
+			},
+		};
+
+	private:
+		void _move_from( InplaceFunction& other )
+		{
+			if ( other._operations == nullptr ) return;
+
+			other._operations->move( _storage, other._storage );
+			_operations = other._operations;
+			other._operations = nullptr;
+		}
+
+	private:
+		alignas( std::max_align_t ) std::byte _storage[Capacity];
+		const Operations* _operations = nullptr;
+	};
+}
@@ -0,0 +1,179 @@
+#include "job-system.h"
+
+#include <algorithm>
+
+using namespace spaceship;
+
+thread_local int JobSystem::_queue_index = JobSystem::EXTERNAL_QUEUE_INDEX;
+
+JobSystem::JobSystem( const int threads_count )
+{
+	const int workers_count = std::max( 0, threads_count );
+
+	_queues.reserve( workers_count + 1 );
+	for ( int i = 0; i < workers_count + 1; i++ )
+	{
+		_queues.push_back( std::make_unique<WorkQueue>() );
+	}
+
+	_threads.reserve( workers_count );
+	for ( int i = 0; i < workers_count; i++ )
+	{
+		_threads.emplace_back( &JobSystem::_run, this, i + 1 );
+	}
+}
+
+JobSystem::~JobSystem()
+{
+	{
+		std::lock_guard lock( _sleep_mutex );
+		_is_stopping = true;
+	}
+	_sleep_condition.notify_all();
+
+	for ( std::thread& thread : _threads )
+	{
+		thread.join();
+	}
+}
+
+void JobSystem::parallel_for( const int count, const int chunk_size, const ChunkTask& task )
+{
+	const int chunks_count = get_chunks_count( count, chunk_size );
+	if ( chunks_count == 0 ) return;
+
+	// Not worth waking workers up
+	if ( chunks_count == 1 || _threads.empty() )
+	{
+		for ( int chunk = 0; chunk < chunks_count; chunk++ )
+		{
+			const int begin = chunk * chunk_size;
+			task( chunk, begin, std::min( begin + chunk_size, count ) );
+		}
+		return;
+	}
+
+	// Lives on the stack until all chunks are done
+	std::atomic<int> remaining_count { chunks_count };
+
+	const int queue_index = _queue_index;
+	for ( int chunk = 0; chunk < chunks_count; chunk++ )
+	{
+		const int begin = chunk * chunk_size;
+		const int end = std::min( begin + chunk_size, count );
+		_push( queue_index,
+			[&task, &remaining_count, chunk, begin, end]
+			{
+				task( chunk, begin, end );
+				remaining_count.fetch_sub( 1, std::memory_order_release );
+			}
+		);
+	}
+
+	// Workers check the queued count under this lock before sleeping
+	{
+		std::lock_guard lock( _sleep_mutex );
+	}
+	_sleep_condition.notify_all();
+
+	// Help instead of blocking, which also supports nested calls from jobs
+	while ( remaining_count.load( std::memory_order_acquire ) > 0 )
+	{
+		if ( !_try_run_one( queue_index ) )
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+void JobSystem::run_parallel( JobSystem* job_system, const int count, const int chunk_size, const ChunkTask& task )
+{
+	if ( job_system != nullptr )
+	{
+		job_system->parallel_for( count, chunk_size, task );
+		return;
+	}
+
+	const int chunks_count = get_chunks_count( count, chunk_size );
+	for ( int chunk = 0; chunk < chunks_count; chunk++ )
+	{
+		const int begin = chunk * chunk_size;
+		task( chunk, begin, std::min( begin + chunk_size, count ) );
+	}
+}
+
+int JobSystem::get_chunks_count( const int count, const int chunk_size )
+{
+	if ( count <= 0 || chunk_size <= 0 ) return 0;
+
+	return ( count + chunk_size - 1 ) / chunk_size;
+}
+
+void JobSystem::_push( const int queue_index, Job job )
+{
+	WorkQueue& queue = *_queues[queue_index];
+	{
+		std::lock_guard lock( queue.mutex );
+		queue.jobs.push_back( std::move( job ) );
+	}
+	_queued_count.fetch_add( 1, std::memory_order_release );
+}
+
+bool JobSystem::_pop( const int queue_index, Job& job )
+{
+	// Newest first, its data is likely still in cache
+	WorkQueue& queue = *_queues[queue_index];
+	std::lock_guard lock( queue.mutex );
+	if ( queue.jobs.empty() ) return false;
+
+	job = std::move( queue.jobs.back() );
+	queue.jobs.pop_back();
+	return true;
+}
+
+bool JobSystem::_steal( const int thief_index, Job& job )
+{
+	// Oldest first, from the next queues so thieves spread over victims
+	const int queues_count = static_cast<int>( _queues.size() );
+	for ( int offset = 1; offset < queues_count; offset++ )
+	{
+		WorkQueue& queue = *_queues[( thief_index + offset ) % queues_count];
+		std::lock_guard lock( queue.mutex );
+		if ( queue.jobs.empty() ) continue;
+
+		job = std::move( queue.jobs.front() );
+		queue.jobs.pop_front();
+		return true;
+	}
+
+	return false;
+}
+
+bool JobSystem::_try_run_one( const int queue_index )
+{
+	Job job;
+	if ( !_pop( queue_index, job ) && !_steal( queue_index, job ) ) return false;
+
+	_queued_count.fetch_sub( 1, std::memory_order_acq_rel );
+	job();
+	return true;
+}
+
+void JobSystem::_run( const int queue_index )
+{
+	_queue_index = queue_index;
+
+	while ( true )
+	{
+		if ( _try_run_one( queue_index ) ) continue;
+
+		std::unique_lock lock( _sleep_mutex );
+		_sleep_condition.wait( lock,
+			[this]
+			{
+				return _is_stopping || _queued_count.load( std::memory_order_acquire ) > 0;
+			}
+		);
+		if ( _is_stopping ) return;
+	}
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace spaceship
+{
+	/*
+	 * Runs short jobs of a frame across worker threads. Each thread owns a queue:
+	 * it pops its newest jobs first, while idle threads steal the oldest jobs of
+	 * other queues. The thread waiting on jobs runs them as well instead of
+	 * blocking.
+	 *
+	 * Work is split in chunks of a fixed size, independently of the threads count,
+	 * so each chunk always covers the same elements. Results are deterministic as
+	 * long as chunks only write to their own elements and defer other effects
+	 * through command buffers, applied in chunks order once all are done.
+	 */
+	class JobSystem
+	{
+	public:
+		using Job = std::function<void()>;
+		using ChunkTask = std::function<void( int chunk_index, int begin, int end )>;
+
+	public:
+		explicit JobSystem( int threads_count );
+		~JobSystem();
+
+		JobSystem( const JobSystem& ) = delete;
+		JobSystem& operator=( const JobSystem& ) = delete;
+
+		/*
+		 * Splits [0; count[ in chunks of the given size and runs the task on each
+		 * of them. Returns once all chunks are done.
+		 */
+		void parallel_for( int count, int chunk_size, const ChunkTask& task );
+
+		int get_threads_count() const { return static_cast<int>( _threads.size() ); }
+
+		/*
+		 * Runs the chunks through the given job system, or serially on the
+		 * calling thread when there is none.
+		 */
+		static void run_parallel( JobSystem* job_system, int count, int chunk_size, const ChunkTask& task );
+		static int get_chunks_count( int count, int chunk_size );
+
+	private:
+		struct WorkQueue
+		{
+			std::mutex mutex;
+			std::deque<Job> jobs;
+		};
+
+	private:
+		void _push( int queue_index, Job job );
+		bool _pop( int queue_index, Job& job );
+		bool _steal( int thief_index, Job& job );
+		bool _try_run_one( int queue_index );
+		void _run( int queue_index );
+
+	private:
+		//  Queue of threads which aren't workers, e.g. the main thread
+		static constexpr int EXTERNAL_QUEUE_INDEX = 0;
+
+	private:
+		std::vector<std::thread> _threads;
+		std::vector<std::unique_ptr<WorkQueue>> _queues;
+
+		//  Number of jobs in all queues, workers sleep while it is zero
+		std::atomic<int> _queued_count { 0 };
+		std::mutex _sleep_mutex;
+		std::condition_variable _sleep_condition;
+		bool _is_stopping = false;
+
+		//  Index of the queue owned by the current thread
+		static thread_local int _queue_index;
+	};
+}
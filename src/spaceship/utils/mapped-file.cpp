@@ -0,0 +1,102 @@
+#include "mapped-file.h"
+
+#ifdef _WIN32
+	#define WIN32_LEAN_AND_MEAN
+	#define NOMINMAX
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+using namespace spaceship;
+
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+bool MappedFile::open( const std::string& path )
+{
+	close();
+
+#ifdef _WIN32
+	const HANDLE file = CreateFileA(
+		path.c_str(),
+		GENERIC_READ,
+		FILE_SHARE_READ,
+		nullptr,
+		OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL,
+		nullptr
+	);
+	if ( file == INVALID_HANDLE_VALUE ) return false;
+
+	LARGE_INTEGER size {};
+	if ( !GetFileSizeEx( file, &size ) || size.QuadPart == 0 )
+	{
+		CloseHandle( file );
+		return false;
+	}
+
+	const HANDLE mapping = CreateFileMappingA( file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+	if ( mapping == nullptr )
+	{
+		CloseHandle( file );
+		return false;
+	}
+
+	const void* data = MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 );
+	if ( data == nullptr )
+	{
+		CloseHandle( mapping );
+		CloseHandle( file );
+		return false;
+	}
+
+	_file_handle = file;
+	_mapping_handle = mapping;
+	_data = static_cast<const unsigned char*>( data );
+	_size = static_cast<size_t>( size.QuadPart );
+#else
+	const int file = ::open( path.c_str(), O_RDONLY );
+	if ( file < 0 ) return false;
+
+	struct stat status {};
+	if ( fstat( file, &status ) != 0 || status.st_size == 0 )
+	{
+		::close( file );
+		return false;
+	}
+
+	void* data = mmap( nullptr, static_cast<size_t>( status.st_size ), PROT_READ, MAP_PRIVATE, file, 0 );
+	// The mapping stays valid once the file is closed
+	::close( file );
+	if ( data == MAP_FAILED ) return false;
+
+	_data = static_cast<const unsigned char*>( data );
+	_size = static_cast<size_t>( status.st_size );
+#endif
+
+	return true;
+}
+
+void MappedFile::close()
+{
+	if ( _data == nullptr ) return;
+
+#ifdef _WIN32
+	UnmapViewOfFile( _data );
+	CloseHandle( _mapping_handle );
+	CloseHandle( _file_handle );
+	_mapping_handle = nullptr;
+	_file_handle = nullptr;
+#else
+	munmap( const_cast<unsigned char*>( _data ), _size );
+#endif
+
+	_data = nullptr;
+	_size = 0;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <string>
+
+namespace spaceship
+{
+	/*
+	 * Read-only memory mapping of a whole file, unmapped on destruction.
+	 */
+	class MappedFile
+	{
+	public:
+		MappedFile() = default;
+		~MappedFile();
+
+		MappedFile( const MappedFile& ) = delete;
+		MappedFile& operator=( const MappedFile& ) = delete;
+
+		bool open( const std::string& path );
+		void close();
+
+		bool is_open() const { return _data != nullptr; }
+		const unsigned char* get_data() const { return _data; }
+		size_t get_size() const { return _size; }
+
+	private:
+		const unsigned char* _data = nullptr;
+		size_t _size = 0;
+
+	#ifdef _WIN32
+		void* _file_handle = nullptr;
+		void* _mapping_handle = nullptr;
+	#endif
+	};
+}
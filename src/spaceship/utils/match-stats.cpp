@@ -0,0 +1,68 @@
+#include "match-stats.h"
+
+#include <spaceship/world.h>
+#include <spaceship/entities/spaceship.h>
+
+using namespace spaceship;
+
+void MatchStatsRecorder::bind( const World& world )
+{
+	for ( const WeakPtr<Spaceship>& wk_ship : world.spaceships )
+	{
+		const SharedPtr<Spaceship> ship = wk_ship.lock();
+		if ( ship == nullptr ) continue;
+
+		_indices[ship->get_unique_id()] = static_cast<int>( _stats.size() );
+		_spaceships.push_back( ship );
+		_stats.push_back( SpaceshipMatchStats {} );
+
+		ship->on_hit.listen( &MatchStatsRecorder::_on_spaceship_hit, this );
+	}
+}
+
+void MatchStatsRecorder::update( const float dt )
+{
+	for ( size_t i = 0; i < _spaceships.size(); i++ )
+	{
+		const SharedPtr<Spaceship> ship = _spaceships[i].lock();
+		if ( ship == nullptr || ship->state != EntityState::Active ) continue;
+
+		_stats[i].survival_time += dt;
+	}
+}
+
+void MatchStatsRecorder::write_rows( std::ostream& stream, const uint32 seed ) const
+{
+	for ( size_t i = 0; i < _stats.size(); i++ )
+	{
+		const SpaceshipMatchStats& stats = _stats[i];
+		stream << seed << ',' << i << ','
+			<< stats.kills << ',' << stats.deaths << ',' << stats.hits << ','
+			<< stats.damage_dealt << ',' << stats.survival_time << '\n';
+	}
+}
+
+void MatchStatsRecorder::write_header( std::ostream& stream )
+{
+	stream << "seed,spaceship,kills,deaths,hits,damage_dealt,survival_time\n";
+}
+
+void MatchStatsRecorder::_on_spaceship_hit( const DamageResult& result )
+{
+	const auto attacker_itr = _indices.find( result.info.attacker->get_unique_id() );
+	if ( attacker_itr == _indices.end() ) return;
+
+	SpaceshipMatchStats& attacker_stats = _stats[attacker_itr->second];
+	attacker_stats.hits++;
+	attacker_stats.damage_dealt += result.info.damage;
+
+	// Only health components of spaceships can be killed
+	const SharedPtr<HealthComponent> victim = result.victim.lock();
+	if ( victim == nullptr || result.is_alive ) return;
+
+	const auto victim_itr = _indices.find( victim->get_owner()->get_unique_id() );
+	if ( victim_itr == _indices.end() ) return;
+
+	attacker_stats.kills++;
+	_stats[victim_itr->second].deaths++;
+}
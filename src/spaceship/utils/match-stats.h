@@ -0,0 +1,59 @@
+#pragma once
+
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+
+#include <suprengine/utils/memory.h>
+
+namespace spaceship
+{
+	using namespace suprengine;
+
+	struct DamageResult;
+	class Spaceship;
+	class World;
+
+	struct SpaceshipMatchStats
+	{
+		int kills = 0;
+		int deaths = 0;
+		//  Projectiles and missiles which damaged a health component or a body
+		int hits = 0;
+		float damage_dealt = 0.0f;
+		//  Time spent alive, respawns excluded
+		float survival_time = 0.0f;
+	};
+
+	/*
+	 * Records the stats of each spaceship of a world during a match, from their
+	 * 'on_hit' events. Spaceships are indexed in their creation order, which is
+	 * deterministic for a given seed.
+	 */
+	class MatchStatsRecorder
+	{
+	public:
+		/*
+		 * Starts recording the spaceships currently in the world.
+		 */
+		void bind( const World& world );
+		void update( float dt );
+
+		/*
+		 * Writes one CSV row per spaceship, prefixed by the match seed.
+		 */
+		void write_rows( std::ostream& stream, uint32 seed ) const;
+		static void write_header( std::ostream& stream );
+
+		const std::vector<SpaceshipMatchStats>& get_stats() const { return _stats; }
+
+	private:
+		void _on_spaceship_hit( const DamageResult& result );
+
+	private:
+		std::vector<WeakPtr<Spaceship>> _spaceships;
+		std::vector<SpaceshipMatchStats> _stats;
+		//  Spaceships unique ids to their stats index
+		std::unordered_map<uint32, int> _indices;
+	};
+}
@@ -0,0 +1,85 @@
+#include "random-stream.h"
+
+using namespace spaceship;
+
+RandomStream::RandomStream( const uint32 seed )
+	: _engine( seed )
+{}
+
+void RandomStream::seed( const uint32 seed )
+{
+	_engine.seed( seed );
+}
+
+int RandomStream::generate( const int min, const int max )
+{
+	if ( max <= min ) return min;
+
+	// Scale the 32-bits output to the range, which is fairer than a modulo
+	const uint64 range = static_cast<uint64>( static_cast<uint32>( max - min ) ) + 1;
+	const uint64 offset = ( static_cast<uint64>( _engine() ) * range ) >> 32;
+	return min + static_cast<int>( offset );
+}
+
+float RandomStream::generate( const float min, const float max )
+{
+	return min + ( max - min ) * _generate_unit();
+}
+
+float RandomStream::generate( const Vec2& bounds )
+{
+	return generate( bounds.x, bounds.y );
+}
+
+Vec3 RandomStream::generate_location(
+	const float min_x, const float min_y, const float min_z,
+	const float max_x, const float max_y, const float max_z
+)
+{
+	// Separate statements, the evaluation order of arguments is unspecified
+	const float x = generate( min_x, max_x );
+	const float y = generate( min_y, max_y );
+	const float z = generate( min_z, max_z );
+	return Vec3 { x, y, z };
+}
+
+Vec3 RandomStream::generate_direction()
+{
+	// Rejection sampling inside the unit sphere, for an uniform distribution
+	while ( true )
+	{
+		const Vec3 point = generate_location( -1.0f, -1.0f, -1.0f, 1.0f, 1.0f, 1.0f );
+		const float length_sqr = point.length_sqr();
+		if ( length_sqr > 0.0001f && length_sqr <= 1.0f )
+		{
+			return point.normalized();
+		}
+	}
+}
+
+Vec3 RandomStream::generate_scale( const float min, const float max )
+{
+	return Vec3( generate( min, max ) );
+}
+
+Color RandomStream::generate_color()
+{
+	const uint8 r = static_cast<uint8>( generate( 0, 255 ) );
+	const uint8 g = static_cast<uint8>( generate( 0, 255 ) );
+	const uint8 b = static_cast<uint8>( generate( 0, 255 ) );
+	return Color { r, g, b, 255 };
+}
+
+Quaternion RandomStream::generate_rotation()
+{
+	const float pitch = generate( -180.0f, 180.0f );
+	const float yaw = generate( -180.0f, 180.0f );
+	const float roll = generate( -180.0f, 180.0f );
+	return Quaternion( DegAngles { pitch, yaw, roll } );
+}
+
+float RandomStream::_generate_unit()
+{
+	// Keep the 24 bits a float can represent exactly
+	return static_cast<float>( _engine() >> 8 ) * ( 1.0f / 16777216.0f );
+}
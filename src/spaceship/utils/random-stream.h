@@ -0,0 +1,56 @@
+#pragma once
+
+#include <random>
+
+#include <suprengine/math/color.h>
+#include <suprengine/math/quaternion.h>
+#include <suprengine/math/vec2.h>
+#include <suprengine/math/vec3.h>
+
+namespace spaceship
+{
+	using namespace suprengine;
+
+	/*
+	 * Seeded random numbers generator, with the same functions as the engine's
+	 * 'random' namespace. Each world owns one, so worlds simulated on different
+	 * threads don't share any generator state and each match only depends on
+	 * its own seed.
+	 *
+	 * Values are mapped from the raw Mersenne Twister output, whose sequence is
+	 * specified by the standard, instead of the standard distributions, which
+	 * differ between libraries.
+	 */
+	class RandomStream
+	{
+	public:
+		explicit RandomStream( uint32 seed = 0 );
+
+		void seed( uint32 seed );
+
+		//  Integer in [min; max]
+		int generate( int min, int max );
+		//  Float in [min; max[
+		float generate( float min, float max );
+		//  Float in [bounds.x; bounds.y[
+		float generate( const Vec2& bounds );
+
+		Vec3 generate_location(
+			float min_x, float min_y, float min_z,
+			float max_x, float max_y, float max_z
+		);
+		Vec3 generate_direction();
+		//  Uniform scale in [min; max[
+		Vec3 generate_scale( float min, float max );
+		//  Opaque color
+		Color generate_color();
+		Quaternion generate_rotation();
+
+	private:
+		//  Float in [0; 1[
+		float _generate_unit();
+
+	private:
+		std::mt19937 _engine;
+	};
+}
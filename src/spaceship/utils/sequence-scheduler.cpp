@@ -0,0 +1,91 @@
+#include "sequence-scheduler.h"
+
+#include <algorithm>
+
+using namespace spaceship;
+
+SequenceScheduler::SequenceScheduler( TimerWheel& timers )
+	: _timers( timers )
+{}
+
+SequenceScheduler::~SequenceScheduler()
+{
+	// Timers of waiting sequences refer to the scheduler
+	for ( const Sequence::Handle handle : _sequences )
+	{
+		_timers.cancel( handle.promise().wait_timer );
+		handle.destroy();
+	}
+}
+
+void SequenceScheduler::start( Sequence sequence, const WeakPtr<Entity>& owner )
+{
+	const Sequence::Handle handle = sequence.release();
+
+	Sequence::promise_type& promise = handle.promise();
+	promise.scheduler = this;
+	promise.owner = owner;
+	promise.has_owner = !owner.expired();
+
+	// Finished sequences are destroyed by the next update
+	_sequences.push_back( handle );
+	handle.resume();
+}
+
+void SequenceScheduler::update()
+{
+	// Sequences queued while resuming wait for the next update
+	_resumed_sequences.swap( _ready_sequences );
+	for ( const Sequence::Handle handle : _resumed_sequences )
+	{
+		Sequence::promise_type& promise = handle.promise();
+		promise.is_ready = false;
+
+		if ( !_is_owner_alive( promise ) ) continue;
+
+		handle.resume();
+	}
+	_resumed_sequences.clear();
+
+	std::erase_if( _sequences,
+		[this]( const Sequence::Handle handle )
+		{
+			const Sequence::promise_type& promise = handle.promise();
+
+			// Queued sequences are destroyed once out of the queue
+			const bool is_cancelled = !_is_owner_alive( promise ) && !promise.is_ready;
+			if ( !handle.done() && !is_cancelled ) return false;
+
+			_timers.cancel( promise.wait_timer );
+			handle.destroy();
+			return true;
+		}
+	);
+}
+
+void SequenceScheduler::wait_seconds( const Sequence::Handle handle, const float seconds )
+{
+	handle.promise().wait_timer = _timers.schedule( seconds,
+		[this, handle]
+		{
+			Sequence::promise_type& promise = handle.promise();
+			promise.wait_timer = TimerHandle {};
+			promise.is_ready = true;
+			_ready_sequences.push_back( handle );
+		}
+	);
+}
+
+void SequenceScheduler::wait_next_tick( const Sequence::Handle handle )
+{
+	handle.promise().is_ready = true;
+	_ready_sequences.push_back( handle );
+}
+
+bool SequenceScheduler::_is_owner_alive( const Sequence::promise_type& promise )
+{
+	if ( !promise.has_owner ) return true;
+
+	const SharedPtr<Entity> owner = promise.owner.lock();
+	return owner != nullptr && owner->state != EntityState::Dead;
+}
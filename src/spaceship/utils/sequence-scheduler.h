@@ -0,0 +1,56 @@
+#pragma once
+
+#include <vector>
+
+#include <spaceship/utils/sequence.h>
+
+namespace spaceship
+{
+	/*
+	 * Runs the sequences of a world. Waiting sequences are queued by the
+	 * world's timers or for the next tick, then resumed together in the next
+	 * update, in queuing order.
+	 *
+	 * A sequence started with an owner is cancelled, its frame destroyed,
+	 * once the owner is killed or destroyed, so sequences can safely use the
+	 * 'this' of their owner.
+	 */
+	class SequenceScheduler
+	{
+	public:
+		explicit SequenceScheduler( TimerWheel& timers );
+		~SequenceScheduler();
+
+		SequenceScheduler( const SequenceScheduler& ) = delete;
+		SequenceScheduler& operator=( const SequenceScheduler& ) = delete;
+
+		/*
+		 * Runs the sequence until its first wait.
+		 */
+		void start( Sequence sequence, const WeakPtr<Entity>& owner = {} );
+
+		/*
+		 * Resumes queued sequences, then destroys finished and cancelled ones.
+		 * Must be called once per frame, after the timers advanced.
+		 */
+		void update();
+
+		void wait_seconds( Sequence::Handle handle, float seconds );
+		void wait_next_tick( Sequence::Handle handle );
+
+		int get_count() const { return static_cast<int>( _sequences.size() ); }
+
+	private:
+		static bool _is_owner_alive( const Sequence::promise_type& promise );
+
+	private:
+		TimerWheel& _timers;
+
+		//  All started and unfinished sequences
+		std::vector<Sequence::Handle> _sequences;
+		//  Sequences resumed by the next update
+		std::vector<Sequence::Handle> _ready_sequences;
+		//  Sequences resumed by the current update
+		std::vector<Sequence::Handle> _resumed_sequences;
+	};
+}
@@ -0,0 +1,20 @@
+#include "sequence.h"
+
+#include <spaceship/utils/sequence-scheduler.h>
+
+using namespace spaceship;
+
+void* Sequence::promise_type::operator new( const size_t size )
+{
+	return CoroutineFramePool::allocate_unpooled( size );
+}
+
+void WaitSecondsAwaiter::await_suspend( const Sequence::Handle handle ) const
+{
+	handle.promise().scheduler->wait_seconds( handle, seconds );
+}
+
+void NextTickAwaiter::await_suspend( const Sequence::Handle handle ) const
+{
+	handle.promise().scheduler->wait_next_tick( handle );
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <utility>
+
+#include <spaceship/utils/coroutine-frame-pool.h>
+#include <spaceship/utils/timer-wheel.h>
+
+namespace spaceship
+{
+	using namespace suprengine;
+
+	class SequenceScheduler;
+
+	/*
+	 * Coroutine running a gameplay script over several frames, started by a
+	 * SequenceScheduler and suspended by awaiting 'wait_seconds' or 'next_tick'.
+	 *
+	 * Frames are allocated from the frame pool of the world of the entity the
+	 * coroutine is a member function of, or from the heap otherwise.
+	 *
+	 * Usage:
+	 * Sequence Spaceship::_blink_sequence()
+	 * {
+	 *     _model_renderer->is_active = false;
+	 *     co_await wait_seconds( 0.5f );
+	 *     _model_renderer->is_active = true;
+	 * }
+	 */
+	class Sequence
+	{
+	public:
+		struct promise_type
+		{
+			Sequence get_return_object()
+			{
+				return Sequence( std::coroutine_handle<promise_type>::from_promise( *this ) );
+			}
+
+			//  Started by the scheduler
+			std::suspend_always initial_suspend() noexcept { return {}; }
+			//  Destroyed by the scheduler
+			std::suspend_always final_suspend() noexcept { return {}; }
+
+			void return_void() {}
+			void unhandled_exception() { std::terminate(); }
+
+			template <typename Owner, typename ...Args>
+				requires requires( Owner& owner ) { owner.get_world().coroutine_frames; }
+			static void* operator new( const size_t size, Owner& owner, Args&... )
+			{
+				return owner.get_world().coroutine_frames.allocate( size );
+			}
+			//  Not a member function of a world entity
+			static void* operator new( size_t size );
+			static void operator delete( void* pointer )
+			{
+				CoroutineFramePool::deallocate( pointer );
+			}
+
+			SequenceScheduler* scheduler = nullptr;
+
+			WeakPtr<Entity> owner;
+			bool has_owner = false;
+
+			//  Timer resuming the sequence, if waiting for one
+			TimerHandle wait_timer {};
+			//  Whether the sequence is queued to be resumed by the next update
+			bool is_ready = false;
+		};
+
+		using Handle = std::coroutine_handle<promise_type>;
+
+	public:
+		Sequence( Sequence&& other ) noexcept
+			: _handle( std::exchange( other._handle, {} ) )
+		{}
+		~Sequence()
+		{
+			// Never started
+			if ( _handle )
+			{
+				_handle.destroy();
+			}
+		}
+
+		Sequence( const Sequence& ) = delete;
+		Sequence& operator=( const Sequence& ) = delete;
+
+		Handle release() { return std::exchange( _handle, {} ); }
+
+	private:
+		explicit Sequence( const Handle handle )
+			: _handle( handle )
+		{}
+
+	private:
+		Handle _handle {};
+	};
+
+	struct WaitSecondsAwaiter
+	{
+		float seconds = 0.0f;
+
+		bool await_ready() const noexcept { return false; }
+		void await_suspend( Sequence::Handle handle ) const;
+		void await_resume() const noexcept {}
+	};
+
+	struct NextTickAwaiter
+	{
+		bool await_ready() const noexcept { return false; }
+		void await_suspend( Sequence::Handle handle ) const;
+		void await_resume() const noexcept {}
+	};
+
+	/*
+	 * Suspends the sequence for the given duration, rounded to the next tick
+	 * of the world's timers.
+	 */
+	inline WaitSecondsAwaiter wait_seconds( const float seconds ) { return WaitSecondsAwaiter { seconds }; }
+	/*
+	 * Suspends the sequence until the next update of its scheduler.
+	 */
+	inline NextTickAwaiter next_tick() { return NextTickAwaiter {}; }
+}
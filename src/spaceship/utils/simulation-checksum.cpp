@@ -0,0 +1,76 @@
+#include "simulation-checksum.h"
+
+#include <bit>
+
+#include <spaceship/world.h>
+#include <spaceship/components/health-component.h>
+
+using namespace spaceship;
+
+void SimulationChecksum::track(
+	World& world,
+	const SharedPtr<Entity>& entity,
+	const SharedPtr<HealthComponent>& health,
+	HashStateCallback hash_state
+)
+{
+	if ( !world.is_checksum_tracking_enabled ) return;
+
+	world.checksum_entities.push_back( TrackedEntity { entity, health, std::move( hash_state ) } );
+}
+
+uint64 SimulationChecksum::compute_tick( World& world )
+{
+	// Entities are hashed in their creation order, which is deterministic
+	std::erase_if( world.checksum_entities,
+		[this]( const TrackedEntity& tracked )
+		{
+			const SharedPtr<Entity> entity = tracked.entity.lock();
+			if ( entity == nullptr ) return true;
+
+			add( entity->get_unique_id() );
+			add( entity->transform->location );
+			add( entity->transform->rotation );
+			add( entity->transform->scale );
+
+			if ( const SharedPtr<HealthComponent> health = tracked.health.lock() )
+			{
+				add( health->health );
+			}
+
+			if ( tracked.hash_state )
+			{
+				tracked.hash_state( *this );
+			}
+
+			return false;
+		}
+	);
+
+	return _value;
+}
+
+void SimulationChecksum::add( const uint32 value )
+{
+	_value = ( _value ^ value ) * FNV_PRIME;
+}
+
+void SimulationChecksum::add( const float value )
+{
+	add( std::bit_cast<uint32>( value ) );
+}
+
+void SimulationChecksum::add( const Vec3& value )
+{
+	add( value.x );
+	add( value.y );
+	add( value.z );
+}
+
+void SimulationChecksum::add( const Quaternion& value )
+{
+	add( value.x );
+	add( value.y );
+	add( value.z );
+	add( value.w );
+}
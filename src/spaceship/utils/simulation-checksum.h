@@ -0,0 +1,70 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include <suprengine/core/entity.h>
+
+namespace spaceship
+{
+	using namespace suprengine;
+
+	class HealthComponent;
+	class World;
+
+	/*
+	 * Rolling checksum of the transforms and health values of tracked entities.
+	 * Computed at each tick, it allows to compare two simulation runs bit-for-bit,
+	 * e.g. before and after optimizing a hot path.
+	 *
+	 * Tracked entities are stored in their world. Tracking is disabled by default
+	 * so the list doesn't keep control blocks alive when nobody computes the
+	 * checksum.
+	 */
+	class SimulationChecksum
+	{
+	public:
+		using HashStateCallback = std::function<void( SimulationChecksum& )>;
+
+		struct TrackedEntity
+		{
+			WeakPtr<Entity> entity;
+			WeakPtr<HealthComponent> health;
+			HashStateCallback hash_state;
+		};
+
+	public:
+		/*
+		 * Tracks an entity transform and, optionally, its health and any additional
+		 * state hashed by the given callback, which is only called while the entity
+		 * is alive.
+		 */
+		static void track(
+			World& world,
+			const SharedPtr<Entity>& entity,
+			const SharedPtr<HealthComponent>& health = nullptr,
+			HashStateCallback hash_state = nullptr
+		);
+
+		/*
+		 * Hashes the current state of all tracked entities of the world and rolls it
+		 * into the running checksum. Expired entities are removed from tracking.
+		 */
+		uint64 compute_tick( World& world );
+
+		void add( uint32 value );
+		void add( float value );
+		void add( const Vec3& value );
+		void add( const Quaternion& value );
+
+		uint64 get_value() const { return _value; }
+
+	private:
+		//  FNV-1a 64-bits parameters
+		static constexpr uint64 FNV_OFFSET_BASIS = 0xcbf29ce484222325;
+		static constexpr uint64 FNV_PRIME = 0x100000001b3;
+
+	private:
+		uint64 _value = FNV_OFFSET_BASIS;
+	};
+}
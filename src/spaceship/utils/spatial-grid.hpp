@@ -0,0 +1,194 @@
+#pragma once
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+#include <suprengine/math/vec3.h>
+
+namespace spaceship
+{
+	using namespace suprengine;
+
+	/*
+	 * Uniform grid over items with a location, rebuilt from scratch whenever
+	 * the items move. Cells are stored sparsely: items are sorted by cell and each
+	 * non-empty cell references its range, so the grid has no bounds.
+	 */
+	template <typename T>
+	class SpatialGrid
+	{
+	public:
+		struct Entry
+		{
+			Vec3 location;
+			T item;
+		};
+
+	public:
+		explicit SpatialGrid( const float cell_size )
+			: _cell_size( cell_size ), _inverse_cell_size( 1.0f / cell_size )
+		{}
+
+		void clear()
+		{
+			_entries.clear();
+			_cells.clear();
+			_is_built = true;
+		}
+
+		/*
+		 * Adds an item, the grid must be re-built before being queried again.
+		 */
+		void insert( const Vec3& location, const T& item )
+		{
+			_entries.push_back( BuildEntry { _get_cell_key( location ), Entry { location, item } } );
+			_is_built = false;
+		}
+
+		void build()
+		{
+			std::sort( _entries.begin(), _entries.end(),
+				[]( const BuildEntry& lhs, const BuildEntry& rhs )
+				{
+					return lhs.key < rhs.key;
+				}
+			);
+
+			_cells.clear();
+			const int count = static_cast<int>( _entries.size() );
+			for ( int i = 0; i < count; )
+			{
+				const uint64 key = _entries[i].key;
+
+				int end = i + 1;
+				while ( end < count && _entries[end].key == key )
+				{
+					end++;
+				}
+
+				_cells[key] = CellRange { i, end - i };
+				i = end;
+			}
+
+			_is_built = true;
+		}
+
+		/*
+		 * Calls the callback for each entry inside the axis-aligned box. Entries in
+		 * overlapping cells but outside of the box may be visited too, callers are
+		 * expected to do their own precise test.
+		 */
+		template <typename Callback>
+		void query_box( const Vec3& min, const Vec3& max, Callback&& callback ) const
+		{
+			ASSERT( _is_built );
+
+			const int32 min_x = _to_cell( min.x ), max_x = _to_cell( max.x );
+			const int32 min_y = _to_cell( min.y ), max_y = _to_cell( max.y );
+			const int32 min_z = _to_cell( min.z ), max_z = _to_cell( max.z );
+
+			for ( int32 x = min_x; x <= max_x; x++ )
+			{
+				for ( int32 y = min_y; y <= max_y; y++ )
+				{
+					for ( int32 z = min_z; z <= max_z; z++ )
+					{
+						const auto itr = _cells.find( _pack_cell_key( x, y, z ) );
+						if ( itr == _cells.end() ) continue;
+
+						const CellRange& range = itr->second;
+						for ( int i = range.first; i < range.first + range.count; i++ )
+						{
+							callback( _entries[i].entry );
+						}
+					}
+				}
+			}
+		}
+
+		template <typename Callback>
+		void query_sphere( const Vec3& center, const float radius, Callback&& callback ) const
+		{
+			const Vec3 extents( radius );
+			query_box( center - extents, center + extents, callback );
+		}
+
+		/*
+		 * Visits the cells overlapping the bounds of a cone defined by its apex, its
+		 * normalized direction, its length and the cosine of its half-angle.
+		 */
+		template <typename Callback>
+		void query_cone(
+			const Vec3& apex,
+			const Vec3& direction,
+			const float length,
+			const float cos_half_angle,
+			Callback&& callback
+		) const
+		{
+			// Bounds of the cone base disk, expanded to the apex
+			const float sin_half_angle = math::sqrt( math::max( 0.0f, 1.0f - cos_half_angle * cos_half_angle ) );
+			const float base_radius = length * sin_half_angle / math::max( cos_half_angle, 0.001f );
+			const Vec3 base_center = apex + direction * length;
+			const Vec3 base_extents {
+				base_radius * math::sqrt( math::max( 0.0f, 1.0f - direction.x * direction.x ) ),
+				base_radius * math::sqrt( math::max( 0.0f, 1.0f - direction.y * direction.y ) ),
+				base_radius * math::sqrt( math::max( 0.0f, 1.0f - direction.z * direction.z ) ),
+			};
+
+			query_box(
+				Vec3::min( apex, base_center - base_extents ),
+				Vec3::max( apex, base_center + base_extents ),
+				callback
+			);
+		}
+
+		int get_count() const { return static_cast<int>( _entries.size() ); }
+		float get_cell_size() const { return _cell_size; }
+
+	private:
+		struct BuildEntry
+		{
+			uint64 key;
+			Entry entry;
+		};
+
+		struct CellRange
+		{
+			int first;
+			int count;
+		};
+
+		//  Cell coordinates are packed on 21 bits per axis
+		static constexpr int32 CELL_COORDINATE_BIAS = 1 << 20;
+		static constexpr uint64 CELL_COORDINATE_MASK = ( 1 << 21 ) - 1;
+
+	private:
+		int32 _to_cell( const float value ) const
+		{
+			return static_cast<int32>( math::floor( value * _inverse_cell_size ) );
+		}
+
+		uint64 _get_cell_key( const Vec3& location ) const
+		{
+			return _pack_cell_key( _to_cell( location.x ), _to_cell( location.y ), _to_cell( location.z ) );
+		}
+
+		static uint64 _pack_cell_key( const int32 x, const int32 y, const int32 z )
+		{
+			return ( static_cast<uint64>( x + CELL_COORDINATE_BIAS ) & CELL_COORDINATE_MASK )
+				| ( ( static_cast<uint64>( y + CELL_COORDINATE_BIAS ) & CELL_COORDINATE_MASK ) << 21 )
+				| ( ( static_cast<uint64>( z + CELL_COORDINATE_BIAS ) & CELL_COORDINATE_MASK ) << 42 );
+		}
+
+	private:
+		float _cell_size;
+		float _inverse_cell_size;
+
+		bool _is_built = true;
+
+		std::vector<BuildEntry> _entries;
+		std::unordered_map<uint64, CellRange> _cells;
+	};
+}
@@ -0,0 +1,213 @@
+#include "timer-wheel.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace spaceship;
+
+TimerWheel::TimerWheel()
+{
+	std::fill( std::begin( _heads ), std::end( _heads ), -1 );
+	std::fill( std::begin( _tails ), std::end( _tails ), -1 );
+}
+
+TimerHandle TimerWheel::schedule( const float delay, Callback callback, const WeakPtr<Entity>& owner )
+{
+	const double delay_ticks = std::ceil( static_cast<double>( delay ) * TICKS_PER_SECOND - TICK_EPSILON );
+	const uint64 ticks = delay_ticks > 0.0
+		? std::min( static_cast<uint64>( delay_ticks ), MAX_DELAY_TICKS )
+		: 0;
+
+	// Re-use a free node
+	int32 index = -1;
+	if ( !_free_nodes.empty() )
+	{
+		index = _free_nodes.back();
+		_free_nodes.pop_back();
+	}
+	else
+	{
+		index = static_cast<int32>( _nodes.size() );
+		_nodes.emplace_back();
+	}
+
+	Node& node = _nodes[index];
+	node.callback = std::move( callback );
+	node.owner = owner;
+	node.has_owner = !owner.expired();
+	node.expire_tick = _tick + ticks;
+	_insert( index );
+	_pending_count++;
+
+	return TimerHandle { index, node.generation };
+}
+
+void TimerWheel::cancel( const TimerHandle handle )
+{
+	if ( !handle.is_valid() || handle.index >= static_cast<int32>( _nodes.size() ) ) return;
+
+	Node& node = _nodes[handle.index];
+	if ( node.generation != handle.generation || node.list == -1 ) return;
+
+	// Nodes being fired are skipped by the firing loop, which frees them
+	if ( node.list == FIRING_LIST )
+	{
+		node.callback.reset();
+		node.generation++;
+		return;
+	}
+
+	_unlink( handle.index );
+	_free( handle.index );
+	_pending_count--;
+}
+
+void TimerWheel::advance( const float dt )
+{
+	_elapsed_time += dt;
+
+	const uint64 target_tick = static_cast<uint64>( _elapsed_time * TICKS_PER_SECOND + TICK_EPSILON );
+	while ( _tick < target_tick )
+	{
+		_step();
+	}
+}
+
+void TimerWheel::_step()
+{
+	const int slot = static_cast<int>( _tick & SLOT_MASK );
+
+	// The first level wrapped around, bring timers of the next range down
+	if ( slot == 0 )
+	{
+		for ( int level = 1; level < LEVELS_COUNT; level++ )
+		{
+			const int level_slot = static_cast<int>( ( _tick >> ( SLOT_BITS * level ) ) & SLOT_MASK );
+			_cascade( level, level_slot );
+
+			if ( level_slot != 0 ) break;
+		}
+	}
+
+	// Detach expired timers, so callbacks can schedule new ones safely
+	int32 index = _detach_list( slot );
+	for ( int32 i = index; i != -1; i = _nodes[i].next )
+	{
+		_nodes[i].list = FIRING_LIST;
+	}
+	_tick++;
+
+	while ( index != -1 )
+	{
+		// Nodes may be re-allocated by callbacks, don't keep references
+		Node& node = _nodes[index];
+		const int32 next = node.next;
+
+		const bool is_owner_alive = !node.has_owner || !node.owner.expired();
+		if ( node.callback && is_owner_alive )
+		{
+			Callback callback = std::move( node.callback );
+			_free( index );
+			_pending_count--;
+
+			callback();
+		}
+		else
+		{
+			_free( index );
+			_pending_count--;
+		}
+
+		index = next;
+	}
+}
+
+void TimerWheel::_cascade( const int level, const int slot )
+{
+	int32 index = _detach_list( level * SLOTS_COUNT + slot );
+	while ( index != -1 )
+	{
+		const int32 next = _nodes[index].next;
+		_insert( index );
+		index = next;
+	}
+}
+
+void TimerWheel::_insert( const int32 index )
+{
+	Node& node = _nodes[index];
+	const uint64 delta = node.expire_tick - _tick;
+
+	// Find the first level whose range covers the delay
+	int level = 0;
+	while ( level < LEVELS_COUNT - 1 && delta >= ( uint64 { 1 } << ( SLOT_BITS * ( level + 1 ) ) ) )
+	{
+		level++;
+	}
+
+	const int slot = static_cast<int>( ( node.expire_tick >> ( SLOT_BITS * level ) ) & SLOT_MASK );
+	const int32 list = level * SLOTS_COUNT + slot;
+
+	// Append to keep the scheduling order
+	node.list = list;
+	node.previous = _tails[list];
+	node.next = -1;
+	if ( _tails[list] != -1 )
+	{
+		_nodes[_tails[list]].next = index;
+	}
+	else
+	{
+		_heads[list] = index;
+	}
+	_tails[list] = index;
+}
+
+void TimerWheel::_unlink( const int32 index )
+{
+	Node& node = _nodes[index];
+
+	if ( node.previous != -1 )
+	{
+		_nodes[node.previous].next = node.next;
+	}
+	else
+	{
+		_heads[node.list] = node.next;
+	}
+
+	if ( node.next != -1 )
+	{
+		_nodes[node.next].previous = node.previous;
+	}
+	else
+	{
+		_tails[node.list] = node.previous;
+	}
+
+	node.list = -1;
+	node.previous = -1;
+	node.next = -1;
+}
+
+int32 TimerWheel::_detach_list( const int32 list )
+{
+	const int32 head = _heads[list];
+	_heads[list] = -1;
+	_tails[list] = -1;
+	return head;
+}
+
+void TimerWheel::_free( const int32 index )
+{
+	Node& node = _nodes[index];
+	node.callback.reset();
+	node.owner.reset();
+	node.has_owner = false;
+	node.generation++;
+	node.list = -1;
+	node.previous = -1;
+	node.next = -1;
+
+	_free_nodes.push_back( index );
+}
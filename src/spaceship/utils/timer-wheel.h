@@ -0,0 +1,110 @@
+#pragma once
+
+#include <vector>
+
+#include <spaceship/utils/inplace-function.hpp>
+
+#include <suprengine/core/entity.h>
+
+namespace spaceship
+{
+	using namespace suprengine;
+
+	/*
+	 * Identifies a scheduled timer, stays safe to cancel once the timer has
+	 * fired or been cancelled.
+	 */
+	struct TimerHandle
+	{
+		int32 index = -1;
+		uint32 generation = 0;
+
+		bool is_valid() const { return index >= 0; }
+	};
+
+	/*
+	 * Hierarchical timing wheel: timers are stored in slots of ticks, the
+	 * first level covers the next 64 ticks and each next level covers 64
+	 * times more, cascading its slots into lower levels as time advances.
+	 * Scheduling and cancelling are O(1), advancing is O(1) per tick plus
+	 * the fired and cascaded timers.
+	 *
+	 * Callbacks are stored inline in recycled nodes, so scheduling doesn't
+	 * allocate once enough nodes exist. Timers fire at the first tick reached
+	 * after their delay, in an order only depending on the scheduling calls.
+	 * Timers with an owner are skipped if it has been destroyed before they
+	 * fire.
+	 */
+	class TimerWheel
+	{
+	public:
+		using Callback = InplaceFunction<void(), 64>;
+
+	public:
+		TimerWheel();
+
+		TimerHandle schedule( float delay, Callback callback, const WeakPtr<Entity>& owner = {} );
+		void cancel( TimerHandle handle );
+
+		/*
+		 * Advances time by the given delta and fires timers which expired.
+		 */
+		void advance( float dt );
+
+		int get_pending_count() const { return _pending_count; }
+		uint64 get_tick() const { return _tick; }
+
+	public:
+		static constexpr int TICKS_PER_SECOND = 120;
+		static constexpr int LEVELS_COUNT = 4;
+		static constexpr int SLOT_BITS = 6;
+		static constexpr int SLOTS_COUNT = 1 << SLOT_BITS;
+		static constexpr uint64 SLOT_MASK = SLOTS_COUNT - 1;
+		//  Delays beyond the range of the wheel, about 38 hours, are clamped
+		static constexpr uint64 MAX_DELAY_TICKS = ( uint64 { 1 } << ( SLOT_BITS * LEVELS_COUNT ) ) - 1;
+
+	private:
+		//  List of nodes detached from their slot to be fired
+		static constexpr int32 FIRING_LIST = -2;
+		//  Absorbs rounding errors of accumulated delta times
+		static constexpr double TICK_EPSILON = 1e-6;
+
+	private:
+		struct Node
+		{
+			Callback callback;
+			WeakPtr<Entity> owner;
+			bool has_owner = false;
+
+			uint64 expire_tick = 0;
+			uint32 generation = 0;
+
+			//  Slot list containing the node, negative when free
+			int32 list = -1;
+			int32 previous = -1;
+			int32 next = -1;
+		};
+
+	private:
+		void _step();
+		void _cascade( int level, int slot );
+
+		void _insert( int32 index );
+		void _unlink( int32 index );
+		int32 _detach_list( int32 list );
+		void _free( int32 index );
+
+	private:
+		uint64 _tick = 0;
+		double _elapsed_time = 0.0;
+
+		int _pending_count = 0;
+
+		std::vector<Node> _nodes;
+		std::vector<int32> _free_nodes;
+
+		//  First and last nodes of each slot list, slots of all levels are stored in a row
+		int32 _heads[LEVELS_COUNT * SLOTS_COUNT];
+		int32 _tails[LEVELS_COUNT * SLOTS_COUNT];
+	};
+}
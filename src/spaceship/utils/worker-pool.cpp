@@ -0,0 +1,70 @@
+#include "worker-pool.h"
+
+#include <algorithm>
+
+using namespace spaceship;
+
+WorkerPool::WorkerPool( const int threads_count )
+{
+	_threads.reserve( threads_count );
+	for ( int i = 0; i < threads_count; i++ )
+	{
+		_threads.emplace_back( &WorkerPool::_run, this );
+	}
+}
+
+WorkerPool::~WorkerPool()
+{
+	{
+		std::lock_guard lock( _mutex );
+		_is_stopping = true;
+	}
+	_condition.notify_all();
+
+	for ( std::thread& thread : _threads )
+	{
+		thread.join();
+	}
+}
+
+void WorkerPool::submit( std::function<void()> task )
+{
+	// Without threads, run it right away
+	if ( _threads.empty() )
+	{
+		task();
+		return;
+	}
+
+	{
+		std::lock_guard lock( _mutex );
+		_tasks.push_back( std::move( task ) );
+	}
+	_condition.notify_one();
+}
+
+int WorkerPool::get_default_threads_count()
+{
+	const int cores_count = static_cast<int>( std::thread::hardware_concurrency() );
+	return std::max( 1, cores_count - 1 );
+}
+
+void WorkerPool::_run()
+{
+	while ( true )
+	{
+		std::function<void()> task;
+		{
+			std::unique_lock lock( _mutex );
+			_condition.wait( lock, [this] { return _is_stopping || !_tasks.empty(); } );
+
+			// Finish remaining tasks before stopping
+			if ( _tasks.empty() ) return;
+
+			task = std::move( _tasks.front() );
+			_tasks.pop_front();
+		}
+
+		task();
+	}
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace spaceship
+{
+	/*
+	 * Fixed set of threads running submitted tasks in submission order.
+	 * Remaining tasks are finished before the threads are joined on destruction.
+	 */
+	class WorkerPool
+	{
+	public:
+		explicit WorkerPool( int threads_count );
+		~WorkerPool();
+
+		WorkerPool( const WorkerPool& ) = delete;
+		WorkerPool& operator=( const WorkerPool& ) = delete;
+
+		void submit( std::function<void()> task );
+
+		int get_threads_count() const { return static_cast<int>( _threads.size() ); }
+
+		/*
+		 * Returns a threads count leaving one core to the main thread.
+		 */
+		static int get_default_threads_count();
+
+	private:
+		void _run();
+
+	private:
+		std::vector<std::thread> _threads;
+
+		std::mutex _mutex;
+		std::condition_variable _condition;
+		std::deque<std::function<void()>> _tasks;
+		bool _is_stopping = false;
+	};
+}
@@ -0,0 +1,121 @@
+#include "world.h"
+
+#include <spaceship/entities/explosion-effect.h>
+#include <spaceship/entities/guided-missile.h>
+#include <spaceship/entities/spaceship.h>
+#include <spaceship/utils/entity-pool.hpp>
+
+using namespace spaceship;
+
+World::World( const uint32 seed )
+	: random( seed ),
+	  _seed( seed ),
+	  _missiles_pool( std::make_unique<EntityPool<GuidedMissile>>( *this ) ),
+	  _explosions_pool( std::make_unique<EntityPool<ExplosionEffect>>( *this ) )
+{}
+
+World::~World()
+{
+	// Entities refer to the world until their destruction, release them while it is complete
+	for ( const SharedPtr<Entity>& entity : _entities )
+	{
+		entity->kill();
+	}
+	_missiles_pool->clear();
+	_explosions_pool->clear();
+	_entities.clear();
+}
+
+void World::update( const float dt )
+{
+	ASSERT( !_is_interpolated );
+
+	// Entities spawned or un-pooled during the tick aren't interpolated,
+	// they would slide from their previous location
+	_interpolated_transforms.clear();
+	if ( should_interpolate_transforms )
+	{
+		for ( const SharedPtr<Entity>& entity : _entities )
+		{
+			if ( entity->state != EntityState::Active ) continue;
+
+			InterpolatedTransform& snapshot = _interpolated_transforms.emplace_back();
+			snapshot.wk_entity = entity;
+			snapshot.previous_location = entity->transform->location;
+			snapshot.previous_rotation = entity->transform->rotation;
+		}
+	}
+
+	timers.advance( dt );
+	sequences.update();
+
+	Spaceship::update_spatial_index( *this );
+	targeting.update( *this );
+	Spaceship::update_all( *this, dt );
+
+	// Entities created during the update are appended, and only updated from the next one
+	const int count = get_entities_count();
+	for ( int i = 0; i < count; i++ )
+	{
+		// Entities stay alive in the list until the end of the update
+		Entity& entity = *_entities[i];
+		if ( entity.state != EntityState::Active ) continue;
+
+		entity.update( dt );
+	}
+
+	std::erase_if( _entities,
+		[]( const SharedPtr<Entity>& entity )
+		{
+			return entity->state == EntityState::Dead;
+		}
+	);
+}
+
+void World::interpolate_transforms( const float alpha )
+{
+	ASSERT( !_is_interpolated );
+
+	for ( InterpolatedTransform& snapshot : _interpolated_transforms )
+	{
+		const SharedPtr<Entity> entity = snapshot.wk_entity.lock();
+		if ( entity == nullptr ) continue;
+
+		Transform& transform = *entity->transform;
+		snapshot.location = transform.location;
+		snapshot.rotation = transform.rotation;
+		transform.set_location( Vec3::lerp( snapshot.previous_location, snapshot.location, alpha ) );
+		transform.set_rotation( Quaternion::slerp( snapshot.previous_rotation, snapshot.rotation, alpha ) );
+	}
+
+	_is_interpolated = true;
+}
+
+void World::restore_transforms()
+{
+	if ( !_is_interpolated ) return;
+
+	for ( const InterpolatedTransform& snapshot : _interpolated_transforms )
+	{
+		const SharedPtr<Entity> entity = snapshot.wk_entity.lock();
+		if ( entity == nullptr ) continue;
+
+		entity->transform->set_location( snapshot.location );
+		entity->transform->set_rotation( snapshot.rotation );
+	}
+
+	_is_interpolated = false;
+}
+
+void World::_bind( WorldEntity& entity )
+{
+	entity._world = this;
+}
+
+void World::_add_entity( const SharedPtr<Entity>& entity )
+{
+	_entities.push_back( entity );
+
+	// Creates the transform, then sets up the entity, registering its components to the engine
+	entity->init();
+}
@@ -0,0 +1,217 @@
+#pragma once
+
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include <spaceship/physics/segment-query.h>
+#include <spaceship/systems/targeting-service.h>
+#include <spaceship/utils/ai-update-scheduler.h>
+#include <spaceship/utils/command-buffer.h>
+#include <spaceship/utils/coroutine-frame-pool.h>
+#include <spaceship/utils/random-stream.h>
+#include <spaceship/utils/sequence-scheduler.h>
+#include <spaceship/utils/simulation-checksum.h>
+#include <spaceship/utils/spatial-grid.hpp>
+#include <spaceship/utils/timer-wheel.h>
+
+#include <suprengine/core/entity.h>
+
+namespace suprengine
+{
+	class Collider;
+}
+
+namespace spaceship
+{
+	using namespace suprengine;
+
+	class CollisionBodySource;
+	class CollisionBroadphase;
+	class CurveTable;
+	class ExplosionEffect;
+	class GuidedMissile;
+	class JobSystem;
+	class ProjectileSystem;
+	class Spaceship;
+	class WorldEntity;
+
+	template <typename T>
+	class EntityPool;
+
+	/*
+	 * Gameplay state of a match: entities, random numbers generator, spaceships
+	 * registry, collision registrations, systems, pools, timers and tracked
+	 * checksum entities. Gameplay code reaches them through the world of its
+	 * entities instead of statics, so matches don't share gameplay state.
+	 *
+	 * Entities are owned and updated by their world, not by the engine. However,
+	 * their setup still creates components registered to the engine singleton
+	 * and takes unique ids from it, which pools also do mid-match when growing.
+	 * Worlds must then be created and updated from the same thread, one after
+	 * the other; parallel matches run in separate processes instead.
+	 */
+	class World
+	{
+	public:
+		struct SpaceshipIndexItem
+		{
+			WeakPtr<Spaceship> wk_ship;
+			uint32 unique_id;
+		};
+
+		struct RegisteredCollider
+		{
+			WeakPtr<Collider> collider;
+			float bounding_radius;
+		};
+
+	public:
+		explicit World( uint32 seed );
+		~World();
+
+		World( const World& ) = delete;
+		World& operator=( const World& ) = delete;
+
+		/*
+		 * Creates an entity belonging to this world. World entities know their
+		 * world before their setup. Entities created during an update are
+		 * updated from the next one.
+		 */
+		template <typename T, typename ...Args>
+		SharedPtr<T> create_entity( Args&& ...args )
+		{
+			SharedPtr<T> entity = std::make_shared<T>( std::forward<Args>( args )... );
+			if constexpr ( std::is_base_of_v<WorldEntity, T> )
+			{
+				_bind( *entity );
+			}
+			_add_entity( entity );
+			return entity;
+		}
+
+		/*
+		 * Advances the simulation: timers, sequences, spaceships, then other
+		 * entities in creation order. Killed entities are removed at the end.
+		 */
+		void update( float dt );
+		/*
+		 * Moves entities between their transforms of the previous and last ticks,
+		 * for rendering only. Must be undone with 'restore_transforms' before the
+		 * next update, and needs 'should_interpolate_transforms' to be enabled.
+		 */
+		void interpolate_transforms( float alpha );
+		void restore_transforms();
+		/*
+		 * Schedules a callback, skipped if the owner is destroyed before the delay.
+		 */
+		TimerHandle add_timer( float delay, TimerWheel::Callback callback, const WeakPtr<Entity>& owner = {} )
+		{
+			return timers.schedule( delay, std::move( callback ), owner );
+		}
+
+		uint32 get_seed() const { return _seed; }
+		int get_entities_count() const { return static_cast<int>( _entities.size() ); }
+
+		SharedPtr<CollisionBroadphase> get_broadphase() const { return wk_broadphase.lock(); }
+		SharedPtr<ProjectileSystem> get_projectile_system() const { return wk_projectile_system.lock(); }
+
+		EntityPool<GuidedMissile>& get_missiles_pool() { return *_missiles_pool; }
+		EntityPool<ExplosionEffect>& get_explosions_pool() { return *_explosions_pool; }
+
+	public:
+		//  Cell size of the spaceships spatial index
+		static constexpr float SPACESHIPS_INDEX_CELL_SIZE = 128.0f;
+
+	public:
+		//  Seeded by the world seed, only used on the updating thread
+		RandomStream random;
+
+		//  Keep the transforms of the previous tick, to interpolate them when rendering
+		bool should_interpolate_transforms = false;
+
+		//  Runs the jobs of the simulation, which is updated serially when null
+		JobSystem* job_system = nullptr;
+		//  Baked explosion curves, shared by all worlds and never modified
+		const CurveTable* explosion_curves = nullptr;
+
+		//  Spaceships in creation order
+		std::vector<WeakPtr<Spaceship>> spaceships;
+		//  Live spaceships, re-built once per frame
+		SpatialGrid<SpaceshipIndexItem> spaceships_index { SPACESHIPS_INDEX_CELL_SIZE };
+
+		//  Spaceships updated in the current frame and their commands, kept to avoid re-allocations
+		std::vector<SharedPtr<Spaceship>> spaceships_update_list;
+		std::vector<CommandBuffer> spaceships_update_commands;
+
+		//  Locations AI planning is prioritized around, e.g. players cameras
+		std::vector<Vec3> viewer_locations;
+		//  Declared before the timers and sequences using it
+		CoroutineFramePool coroutine_frames;
+		TimerWheel timers;
+		SequenceScheduler sequences { timers };
+
+		AIUpdateScheduler ai_scheduler;
+		TargetingService targeting;
+		std::vector<AIPlanCandidate> ai_plan_candidates;
+		std::vector<uint8> ai_should_plan;
+
+		//  Look-ahead probes of the current frame and the updated spaceship each belongs to
+		std::vector<SegmentQuery> look_ahead_queries;
+		std::vector<SegmentQueryResult> look_ahead_results;
+		std::vector<int> look_ahead_indices;
+
+		std::vector<RegisteredCollider> registered_colliders;
+		std::vector<WeakPtr<CollisionBodySource>> registered_body_sources;
+
+		WeakPtr<CollisionBroadphase> wk_broadphase;
+		WeakPtr<ProjectileSystem> wk_projectile_system;
+
+		//  Entities hashed by SimulationChecksum, only filled when tracking is enabled
+		bool is_checksum_tracking_enabled = false;
+		std::vector<SimulationChecksum::TrackedEntity> checksum_entities;
+
+	private:
+		struct InterpolatedTransform
+		{
+			WeakPtr<Entity> wk_entity;
+			Vec3 previous_location;
+			Quaternion previous_rotation;
+			//  Last simulated transform, replaced by the interpolated one until restored
+			Vec3 location;
+			Quaternion rotation;
+		};
+
+	private:
+		void _bind( WorldEntity& entity );
+		void _add_entity( const SharedPtr<Entity>& entity );
+
+	private:
+		uint32 _seed = 0;
+
+		//  Entities in creation order, including paused pooled ones
+		std::vector<SharedPtr<Entity>> _entities;
+
+		//  Active entities at the start of the last tick, see 'should_interpolate_transforms'
+		std::vector<InterpolatedTransform> _interpolated_transforms;
+		bool _is_interpolated = false;
+
+		std::unique_ptr<EntityPool<GuidedMissile>> _missiles_pool;
+		std::unique_ptr<EntityPool<ExplosionEffect>> _explosions_pool;
+	};
+
+	/*
+	 * Entity created by a world, which is available from its setup.
+	 */
+	class WorldEntity : public Entity
+	{
+	public:
+		World& get_world() const { return *_world; }
+
+	protected:
+		World* _world = nullptr;
+
+	private:
+		friend class World;
+	};
+}